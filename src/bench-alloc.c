@@ -0,0 +1,91 @@
+/*
+ * Benchmark Allocators
+ *
+ * This compares the allocators of c-stdaux to malloc(3). Each iteration
+ * allocates a batch of small objects of the given size, touches them, and then
+ * releases all of them again, as is typical for per-request state.
+ */
+
+#include "bench.h"
+
+#define BENCH_ALLOC_BATCH 256
+
+typedef struct {
+        void *objects[BENCH_ALLOC_BATCH];
+        CArena *arena;
+        CPool pool;
+        size_t size;
+} BenchAlloc;
+
+static void bench_malloc(void *ctx, size_t n) {
+        BenchAlloc *b = ctx;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < BENCH_ALLOC_BATCH; ++j) {
+                        b->objects[j] = malloc(b->size);
+                        c_assert(b->objects[j]);
+                        *(uint8_t *)b->objects[j] = (uint8_t)j;
+                }
+                bench_clobber();
+                for (j = 0; j < BENCH_ALLOC_BATCH; ++j)
+                        free(b->objects[j]);
+        }
+}
+
+static void bench_c_arena(void *ctx, size_t n) {
+        BenchAlloc *b = ctx;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < BENCH_ALLOC_BATCH; ++j) {
+                        b->objects[j] = c_arena_alloc(b->arena, b->size, alignof(max_align_t));
+                        c_assert(b->objects[j]);
+                        *(uint8_t *)b->objects[j] = (uint8_t)j;
+                }
+                bench_clobber();
+                c_arena_reset(b->arena);
+        }
+}
+
+static void bench_c_pool(void *ctx, size_t n) {
+        BenchAlloc *b = ctx;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < BENCH_ALLOC_BATCH; ++j) {
+                        b->objects[j] = c_pool_alloc(&b->pool);
+                        c_assert(b->objects[j]);
+                        *(uint8_t *)b->objects[j] = (uint8_t)j;
+                }
+                bench_clobber();
+                for (j = 0; j < BENCH_ALLOC_BATCH; ++j)
+                        c_pool_free(&b->pool, b->objects[j]);
+        }
+}
+
+int main(void) {
+        static const size_t sizes[] = { 16, 64, 256 };
+        static BenchAlloc b;
+        size_t i;
+        int r;
+
+        r = c_arena_new(&b.arena, 0);
+        c_assert(!r);
+
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                b.size = sizes[i];
+
+                bench_run("alloc", "malloc", b.size, 0, bench_malloc, &b);
+                bench_run("alloc", "c_arena", b.size, 0, bench_c_arena, &b);
+
+                c_pool_init(&b.pool, b.size, alignof(max_align_t));
+                bench_run("alloc", "c_pool", b.size, 0, bench_c_pool, &b);
+                c_pool_deinit(&b.pool);
+        }
+
+        b.arena = c_arena_free(b.arena);
+        return 0;
+}
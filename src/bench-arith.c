@@ -0,0 +1,78 @@
+/*
+ * Benchmark Arithmetic Helpers
+ *
+ * This compares the type-generic arithmetic macros (c_max(), c_min(),
+ * c_clamp(), c_less_by(), c_div_round_up(), c_align_to()) to open-coded
+ * expressions. Both should generate the same code, so any difference in the
+ * results indicates a code-generation regression.
+ */
+
+#include "bench.h"
+
+#define BENCH_ARITH_N 4096
+
+typedef struct {
+        uint64_t values[BENCH_ARITH_N];
+        uint64_t divisor;
+        uint64_t alignment;
+} BenchArith;
+
+#define BENCH_ARITH(_name, _expr)                                       \
+        static void _name(void *ctx, size_t n) {                        \
+                BenchArith *b = ctx;                                    \
+                _c_unused_ uint64_t x, y;                               \
+                uint64_t sum = 0;                                       \
+                size_t i, j;                                            \
+                                                                        \
+                for (i = 0; i < n; ++i) {                               \
+                        for (j = 0; j + 1 < BENCH_ARITH_N; ++j) {       \
+                                x = b->values[j];                       \
+                                y = b->values[j + 1];                   \
+                                sum += (_expr);                         \
+                        }                                               \
+                        bench_escape(sum);                              \
+                }                                                       \
+        } struct c_internal_trailing_semicolon
+
+BENCH_ARITH(bench_c_max, c_max(x, y));
+BENCH_ARITH(bench_raw_max, x > y ? x : y);
+BENCH_ARITH(bench_c_min, c_min(x, y));
+BENCH_ARITH(bench_raw_min, x < y ? x : y);
+BENCH_ARITH(bench_c_clamp, c_clamp(x, y >> 8, y));
+BENCH_ARITH(bench_raw_clamp, x > y ? y : x < (y >> 8) ? (y >> 8) : x);
+BENCH_ARITH(bench_c_less_by, c_less_by(x, y));
+BENCH_ARITH(bench_raw_less_by, x > y ? x - y : 0);
+BENCH_ARITH(bench_c_div_round_up, c_div_round_up(x, b->divisor));
+BENCH_ARITH(bench_raw_div_round_up, (x + b->divisor - 1) / b->divisor);
+BENCH_ARITH(bench_c_align_to, c_align_to(x, b->alignment));
+BENCH_ARITH(bench_raw_align_to, (x + b->alignment - 1) & ~(b->alignment - 1));
+
+int main(int argc, char **argv) {
+        static BenchArith b;
+        size_t i;
+        uint64_t seed = 1;
+
+        for (i = 0; i < BENCH_ARITH_N; ++i)
+                b.values[i] = bench_random(&seed) >> 8;
+
+        /* hide the divisor and alignment from the optimizer */
+        b.divisor = 3 + (uint64_t)argc;
+        b.alignment = 8u << (argc - 1);
+        (void)argv;
+
+        bench_header();
+        bench_run("max", "c_max", 0, 0, bench_c_max, &b);
+        bench_run("max", "raw", 0, 0, bench_raw_max, &b);
+        bench_run("min", "c_min", 0, 0, bench_c_min, &b);
+        bench_run("min", "raw", 0, 0, bench_raw_min, &b);
+        bench_run("clamp", "c_clamp", 0, 0, bench_c_clamp, &b);
+        bench_run("clamp", "raw", 0, 0, bench_raw_clamp, &b);
+        bench_run("less_by", "c_less_by", 0, 0, bench_c_less_by, &b);
+        bench_run("less_by", "raw", 0, 0, bench_raw_less_by, &b);
+        bench_run("div_round_up", "c_div_round_up", 0, 0, bench_c_div_round_up, &b);
+        bench_run("div_round_up", "raw", 0, 0, bench_raw_div_round_up, &b);
+        bench_run("align_to", "c_align_to", 0, 0, bench_c_align_to, &b);
+        bench_run("align_to", "raw", 0, 0, bench_raw_align_to, &b);
+
+        return 0;
+}
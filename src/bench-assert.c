@@ -0,0 +1,99 @@
+/*
+ * Benchmark Assertions as Optimizer Hints
+ *
+ * This runs the same loop over arrays whose length is asserted to be a
+ * multiple of 8, once with plain c_assert() and once with C_ASSERT_ASSUME,
+ * both compiled with NDEBUG like a release build. Only with the hint can the
+ * compiler vectorize the loop without a scalar remainder, which is often the
+ * deciding factor for its cost model (at -O2, GCC only vectorizes loops that
+ * need no remainder). The reported time is per pass over the array.
+ */
+
+#include "bench.h"
+
+#define BENCH_ASSERT_MAX 16384
+
+typedef struct {
+        _Alignas(64) uint32_t src[BENCH_ASSERT_MAX];
+        _Alignas(64) uint32_t dst[BENCH_ASSERT_MAX];
+        size_t size;
+} BenchAssert;
+
+/*
+ * The assertion mode is picked up whenever c_assert() is expanded, and
+ * <assert.h> follows NDEBUG whenever it is included. Hence, both can be
+ * switched for the kernels below, without affecting the checks of the
+ * benchmark itself.
+ */
+#define NDEBUG 1
+#include <assert.h>
+
+static _c_noinline_ void bench_kernel_plain(uint32_t *restrict dst, const uint32_t *restrict src, size_t n) {
+        size_t i;
+
+        c_assert(n % 8 == 0);
+        for (i = 0; i < n; ++i)
+                dst[i] = src[i] * 3 + 1;
+}
+
+#undef C_ASSERT_ASSUME
+#define C_ASSERT_ASSUME 1
+
+static _c_noinline_ void bench_kernel_assume(uint32_t *restrict dst, const uint32_t *restrict src, size_t n) {
+        size_t i;
+
+        c_assert(n % 8 == 0);
+        for (i = 0; i < n; ++i)
+                dst[i] = src[i] * 3 + 1;
+}
+
+#undef C_ASSERT_ASSUME
+#define C_ASSERT_ASSUME 0
+
+#undef NDEBUG
+#include <assert.h>
+
+static void bench_plain(void *ctx, size_t n) {
+        BenchAssert *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                bench_kernel_plain(b->dst, b->src, b->size);
+                bench_clobber();
+        }
+}
+
+static void bench_assume(void *ctx, size_t n) {
+        BenchAssert *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                bench_kernel_assume(b->dst, b->src, b->size);
+                bench_clobber();
+        }
+}
+
+int main(void) {
+        static const size_t sizes[] = { 8, 64, 1024, BENCH_ASSERT_MAX };
+        static BenchAssert b;
+        size_t i;
+
+        bench_fill(b.src, sizeof(b.src), 1);
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                b.size = sizes[i];
+
+                bench_run("transform", "c_assert", b.size, 0, bench_plain, &b);
+                bench_run("transform", "c_assert_assume", b.size, 0, bench_assume, &b);
+
+                /* verify both kernels cover the entire array */
+                bench_kernel_plain(b.dst, b.src, b.size);
+                c_assert(b.dst[b.size - 1] == b.src[b.size - 1] * 3 + 1);
+                b.dst[b.size - 1] = 0;
+                bench_kernel_assume(b.dst, b.src, b.size);
+                c_assert(b.dst[b.size - 1] == b.src[b.size - 1] * 3 + 1);
+        }
+
+        return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Benchmark Cache-Line Padding
+ *
+ * This runs several threads which each increment their own counter. With the
+ * counters packed next to each other, they share cache lines and every
+ * increment bounces the line between the cores (false sharing). With the
+ * counters padded via C_CACHELINE_PADDED(), each thread owns its line. The
+ * `size` column is the number of threads, and the reported time is per
+ * increment of a single thread.
+ */
+
+#include <pthread.h>
+#include "bench.h"
+
+#define BENCH_CACHELINE_MAX_THREADS 8
+
+typedef C_CACHELINE_PADDED(uint64_t) BenchSlot;
+
+typedef struct {
+        uint64_t packed[BENCH_CACHELINE_MAX_THREADS];
+        BenchSlot padded[BENCH_CACHELINE_MAX_THREADS];
+        size_t n_threads;
+} BenchCacheline;
+
+typedef struct {
+        uint64_t *counter;
+        size_t n;
+} BenchThread;
+
+static void *bench_thread(void *ctx) {
+        BenchThread *t = ctx;
+        uint64_t v;
+        size_t i;
+
+        /* relaxed atomics force a memory access on every iteration */
+        for (i = 0; i < t->n; ++i) {
+                v = c_atomic_load(t->counter, C_ATOMIC_RELAXED);
+                c_atomic_store(t->counter, v + 1, C_ATOMIC_RELAXED);
+        }
+
+        return NULL;
+}
+
+static void bench_counters(BenchCacheline *b, size_t n, bool padded) {
+        pthread_t threads[BENCH_CACHELINE_MAX_THREADS];
+        BenchThread ctx[BENCH_CACHELINE_MAX_THREADS];
+        size_t i;
+        int r;
+
+        for (i = 0; i < b->n_threads; ++i) {
+                ctx[i].counter = padded ? &b->padded[i].value : &b->packed[i];
+                ctx[i].n = n;
+                r = pthread_create(&threads[i], NULL, bench_thread, &ctx[i]);
+                c_assert(!r);
+        }
+
+        for (i = 0; i < b->n_threads; ++i) {
+                r = pthread_join(threads[i], NULL);
+                c_assert(!r);
+        }
+}
+
+static void bench_packed(void *ctx, size_t n) {
+        bench_counters(ctx, n, false);
+}
+
+static void bench_padded(void *ctx, size_t n) {
+        bench_counters(ctx, n, true);
+}
+
+int main(void) {
+        static BenchCacheline b;
+        size_t i;
+
+        bench_header();
+
+        for (i = 1; i <= BENCH_CACHELINE_MAX_THREADS; i *= 2) {
+                b.n_threads = i;
+                bench_run("counters", "packed", i, 0, bench_packed, &b);
+                bench_run("counters", "C_CACHELINE_PADDED", i, 0, bench_padded, &b);
+        }
+
+        return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Benchmark Closing File Descriptor Ranges
+ *
+ * This opens a few sparse file descriptors and closes all of them at once,
+ * via c_closefrom(), via enumerating the open file descriptors, and via
+ * closing every possible file descriptor up to the limit of the process. The
+ * `size` column is the file-descriptor limit, which is what the brute-force
+ * fallback scales with. The reported time includes reopening the file
+ * descriptors.
+ */
+
+#include <sys/resource.h>
+#include "bench.h"
+
+#define BENCH_CLOSE_FIRST 64
+#define BENCH_CLOSE_N 8
+
+static void bench_open(void) {
+        size_t i;
+        int r;
+
+        for (i = 0; i < BENCH_CLOSE_N; ++i) {
+                r = fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, BENCH_CLOSE_FIRST + (int)i * 16);
+                c_assert(r >= BENCH_CLOSE_FIRST);
+        }
+}
+
+static void bench_c_closefrom(void *ctx, size_t n) {
+        size_t i;
+        int r;
+
+        (void)ctx;
+
+        for (i = 0; i < n; ++i) {
+                bench_open();
+                r = c_closefrom(BENCH_CLOSE_FIRST);
+                c_assert(!r);
+        }
+}
+
+static void bench_close_dir(void *ctx, size_t n) {
+        size_t i;
+        int r;
+
+        (void)ctx;
+
+        for (i = 0; i < n; ++i) {
+                bench_open();
+                r = c_internal_close_range_dir(BENCH_CLOSE_FIRST, INT_MAX);
+                c_assert(!r);
+        }
+}
+
+static void bench_close_all(void *ctx, size_t n) {
+        size_t i;
+
+        (void)ctx;
+
+        for (i = 0; i < n; ++i) {
+                bench_open();
+                c_internal_close_range_all(BENCH_CLOSE_FIRST, INT_MAX);
+        }
+}
+
+int main(void) {
+        static const rlim_t limits[] = { 1024, 16384 };
+        struct rlimit rl, orig;
+        size_t i;
+        int r;
+
+        r = getrlimit(RLIMIT_NOFILE, &orig);
+        c_assert(!r);
+
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(limits); ++i) {
+                if (orig.rlim_max != RLIM_INFINITY && limits[i] > orig.rlim_max)
+                        continue;
+
+                rl.rlim_cur = limits[i];
+                rl.rlim_max = orig.rlim_max;
+                r = setrlimit(RLIMIT_NOFILE, &rl);
+                c_assert(!r);
+
+                bench_run("closefrom", "c_closefrom", limits[i], 0, bench_c_closefrom, NULL);
+                bench_run("closefrom", "enumerate", limits[i], 0, bench_close_dir, NULL);
+                bench_run("closefrom", "close_all", limits[i], 0, bench_close_all, NULL);
+        }
+
+        r = setrlimit(RLIMIT_NOFILE, &orig);
+        c_assert(!r);
+        return 0;
+}
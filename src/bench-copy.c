@@ -0,0 +1,100 @@
+/*
+ * Benchmark Copying File Descriptors
+ *
+ * This copies a temporary file to another file and to `/dev/null`, once via
+ * c_copy_fd() and once via a read/write loop through a 64KiB buffer. The
+ * source stays in the page cache, so this measures the cost of the copy
+ * itself. The `size` column is the file size, and the reported time is per
+ * copy.
+ */
+
+#include "bench.h"
+
+#define BENCH_COPY_SIZE (16 * 1024 * 1024)
+#define BENCH_COPY_BUFFER (64 * 1024)
+
+typedef struct {
+        char buffer[BENCH_COPY_BUFFER];
+        int fd_in;
+        int fd_out;
+} BenchCopy;
+
+static void bench_rewind(BenchCopy *b) {
+        int r;
+
+        c_assert(lseek(b->fd_in, 0, SEEK_SET) == 0);
+        c_assert(lseek(b->fd_out, 0, SEEK_SET) == 0);
+        r = ftruncate(b->fd_out, 0);
+        c_assert(!r || errno == EINVAL);
+}
+
+static void bench_c_copy_fd(void *ctx, size_t n) {
+        BenchCopy *b = ctx;
+        size_t i, n_copied;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                bench_rewind(b);
+                r = c_copy_fd(b->fd_in, b->fd_out, SIZE_MAX, &n_copied);
+                c_assert(!r && n_copied == BENCH_COPY_SIZE);
+        }
+}
+
+static void bench_read_write(void *ctx, size_t n) {
+        BenchCopy *b = ctx;
+        size_t i, n_copied;
+        ssize_t l;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                bench_rewind(b);
+
+                for (n_copied = 0; ; n_copied += (size_t)l) {
+                        l = read(b->fd_in, b->buffer, sizeof(b->buffer));
+                        c_assert(l >= 0);
+                        if (!l)
+                                break;
+
+                        r = c_write_full(b->fd_out, b->buffer, (size_t)l, NULL);
+                        c_assert(!r);
+                }
+
+                c_assert(n_copied == BENCH_COPY_SIZE);
+        }
+}
+
+int main(void) {
+        char path_in[] = "/tmp/c-stdaux-bench-XXXXXX", path_out[] = "/tmp/c-stdaux-bench-XXXXXX";
+        static BenchCopy b;
+        void *p;
+        int r;
+
+        p = malloc(BENCH_COPY_SIZE);
+        c_assert(p);
+        bench_fill(p, BENCH_COPY_SIZE, 1);
+
+        b.fd_in = mkstemp(path_in);
+        c_assert(b.fd_in >= 0);
+        r = c_write_full(b.fd_in, p, BENCH_COPY_SIZE, NULL);
+        c_assert(!r);
+        free(p);
+
+        bench_header();
+
+        b.fd_out = mkstemp(path_out);
+        c_assert(b.fd_out >= 0);
+        bench_run("copy-file", "c_copy_fd", BENCH_COPY_SIZE, 0, bench_c_copy_fd, &b);
+        bench_run("copy-file", "read_write", BENCH_COPY_SIZE, 0, bench_read_write, &b);
+        b.fd_out = c_close(b.fd_out);
+        unlink(path_out);
+
+        b.fd_out = open("/dev/null", O_WRONLY | O_CLOEXEC);
+        c_assert(b.fd_out >= 0);
+        bench_run("copy-null", "c_copy_fd", BENCH_COPY_SIZE, 0, bench_c_copy_fd, &b);
+        bench_run("copy-null", "read_write", BENCH_COPY_SIZE, 0, bench_read_write, &b);
+        b.fd_out = c_close(b.fd_out);
+
+        b.fd_in = c_close(b.fd_in);
+        unlink(path_in);
+        return 0;
+}
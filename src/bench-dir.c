@@ -0,0 +1,162 @@
+/*
+ * Benchmark Directory Iterators
+ *
+ * This enumerates a temporary directory via CDirIter and via readdir(3). The
+ * `list` benchmark only reads the entry names, the `classify` benchmark counts
+ * regular files, once based on the reported file type and once by calling
+ * stat(2) on every entry, as many callers do. The `size` column is the number
+ * of entries, and the reported time is per enumeration of the directory.
+ */
+
+#include "bench.h"
+
+#define BENCH_DIR_N (16 * 1024)
+
+typedef struct {
+        char path[64];
+        size_t n_regular;
+} BenchDir;
+
+static size_t bench_dir_iter(BenchDir *b, bool use_stat) {
+        const CDirEntry *entry;
+        CDirIter *iter;
+        struct stat st;
+        size_t n = 0;
+        int r;
+
+        r = c_dir_iter_new(&iter, AT_FDCWD, b->path);
+        c_assert(!r);
+
+        while ((r = c_dir_iter_next(iter, &entry)) > 0) {
+                if (!use_stat && entry->type != DT_UNKNOWN) {
+                        n += entry->type == DT_REG;
+                } else {
+                        r = c_dir_iter_stat(iter, entry, &st);
+                        c_assert(!r);
+                        n += !!S_ISREG(st.st_mode);
+                }
+        }
+        c_assert(!r);
+
+        c_dir_iter_free(iter);
+        return n;
+}
+
+static size_t bench_readdir(BenchDir *b, bool use_stat) {
+        struct dirent *de;
+        struct stat st;
+        size_t n = 0;
+        DIR *d;
+        int r;
+
+        d = opendir(b->path);
+        c_assert(d);
+
+        while ((de = readdir(d))) {
+                if (de->d_name[0] == '.')
+                        continue;
+
+                if (!use_stat) {
+                        ++n;
+                } else {
+                        r = fstatat(dirfd(d), de->d_name, &st, AT_SYMLINK_NOFOLLOW);
+                        c_assert(!r);
+                        n += !!S_ISREG(st.st_mode);
+                }
+        }
+
+        c_closedir(d);
+        return n;
+}
+
+static void bench_list_c_dir_iter(void *ctx, size_t n) {
+        BenchDir *b = ctx;
+        const CDirEntry *entry;
+        CDirIter *iter;
+        size_t i, k;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                r = c_dir_iter_new(&iter, AT_FDCWD, b->path);
+                c_assert(!r);
+                for (k = 0; (r = c_dir_iter_next(iter, &entry)) > 0; ++k)
+                        bench_escape(entry->name);
+                c_assert(!r && k == BENCH_DIR_N);
+                c_dir_iter_free(iter);
+        }
+}
+
+static void bench_list_readdir(void *ctx, size_t n) {
+        BenchDir *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                c_assert(bench_readdir(b, false) == BENCH_DIR_N);
+}
+
+static void bench_classify_c_dir_iter(void *ctx, size_t n) {
+        BenchDir *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                c_assert(bench_dir_iter(b, false) == b->n_regular);
+}
+
+static void bench_classify_c_dir_iter_stat(void *ctx, size_t n) {
+        BenchDir *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                c_assert(bench_dir_iter(b, true) == b->n_regular);
+}
+
+static void bench_classify_readdir_stat(void *ctx, size_t n) {
+        BenchDir *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                c_assert(bench_readdir(b, true) == b->n_regular);
+}
+
+int main(void) {
+        static BenchDir b = { .path = "/tmp/c-stdaux-bench-XXXXXX" };
+        char name[32];
+        size_t i;
+        int r, dfd, fd;
+
+        c_assert(mkdtemp(b.path));
+        dfd = open(b.path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        c_assert(dfd >= 0);
+
+        /* every 8th entry is a directory, the rest are regular files */
+        for (i = 0; i < BENCH_DIR_N; ++i) {
+                snprintf(name, sizeof(name), "entry-%zu", i);
+                if (i % 8) {
+                        fd = openat(dfd, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+                        c_assert(fd >= 0);
+                        c_close(fd);
+                        ++b.n_regular;
+                } else {
+                        r = mkdirat(dfd, name, 0700);
+                        c_assert(!r);
+                }
+        }
+
+        bench_header();
+        bench_run("list", "c_dir_iter", BENCH_DIR_N, 0, bench_list_c_dir_iter, &b);
+        bench_run("list", "readdir", BENCH_DIR_N, 0, bench_list_readdir, &b);
+        bench_run("classify", "c_dir_iter", BENCH_DIR_N, 0, bench_classify_c_dir_iter, &b);
+        bench_run("classify", "c_dir_iter_stat", BENCH_DIR_N, 0, bench_classify_c_dir_iter_stat, &b);
+        bench_run("classify", "readdir_stat", BENCH_DIR_N, 0, bench_classify_readdir_stat, &b);
+
+        for (i = 0; i < BENCH_DIR_N; ++i) {
+                snprintf(name, sizeof(name), "entry-%zu", i);
+                r = unlinkat(dfd, name, i % 8 ? 0 : AT_REMOVEDIR);
+                c_assert(!r);
+        }
+
+        c_close(dfd);
+        r = rmdir(b.path);
+        c_assert(!r);
+        return 0;
+}
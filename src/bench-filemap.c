@@ -0,0 +1,97 @@
+/*
+ * Benchmark Mapped Files
+ *
+ * This loads a temporary file and sums its content, once by reading it into
+ * an allocated buffer, and once via c_file_map_new(), with and without
+ * populating the page tables upfront. The file stays in the page cache, so
+ * this measures the cost of copying and faulting, not of the storage. The
+ * `size` column is the file size, and the reported time is per load.
+ */
+
+#include "bench.h"
+
+#define BENCH_FILEMAP_SIZE (16 * 1024 * 1024)
+
+typedef struct {
+        char path[64];
+        unsigned int flags;
+} BenchFileMap;
+
+static uint64_t bench_sum(const void *p, size_t n) {
+        const uint64_t *v = p;
+        uint64_t sum = 0;
+        size_t i;
+
+        for (i = 0; i < n / sizeof(*v); ++i)
+                sum += v[i];
+
+        return sum;
+}
+
+static void bench_read(void *ctx, size_t n) {
+        BenchFileMap *b = ctx;
+        size_t i, n_read;
+        struct stat st;
+        void *p;
+        int r, fd;
+
+        for (i = 0; i < n; ++i) {
+                fd = open(b->path, O_RDONLY | O_CLOEXEC);
+                c_assert(fd >= 0);
+                r = fstat(fd, &st);
+                c_assert(!r);
+
+                p = malloc((size_t)st.st_size);
+                c_assert(p);
+                r = c_read_full(fd, p, (size_t)st.st_size, &n_read);
+                c_assert(!r && n_read == (size_t)st.st_size);
+
+                bench_escape(bench_sum(p, n_read));
+
+                free(p);
+                c_close(fd);
+        }
+}
+
+static void bench_map(void *ctx, size_t n) {
+        BenchFileMap *b = ctx;
+        CFileMap *map;
+        size_t i;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                r = c_file_map_new(&map, b->path, b->flags);
+                c_assert(!r);
+
+                bench_escape(bench_sum(map->data, map->size));
+
+                c_file_map_free(map);
+        }
+}
+
+int main(void) {
+        static BenchFileMap b = { .path = "/tmp/c-stdaux-bench-XXXXXX" };
+        void *p;
+        int r, fd;
+
+        p = malloc(BENCH_FILEMAP_SIZE);
+        c_assert(p);
+        bench_fill(p, BENCH_FILEMAP_SIZE, 1);
+
+        fd = mkstemp(b.path);
+        c_assert(fd >= 0);
+        r = c_write_full(fd, p, BENCH_FILEMAP_SIZE, NULL);
+        c_assert(!r);
+        c_close(fd);
+        free(p);
+
+        bench_header();
+        bench_run("load", "read", BENCH_FILEMAP_SIZE, 0, bench_read, &b);
+        b.flags = C_FILE_MAP_SEQUENTIAL;
+        bench_run("load", "c_file_map", BENCH_FILEMAP_SIZE, 0, bench_map, &b);
+        b.flags = C_FILE_MAP_POPULATE;
+        bench_run("load", "c_file_map_populate", BENCH_FILEMAP_SIZE, 0, bench_map, &b);
+
+        unlink(b.path);
+        return 0;
+}
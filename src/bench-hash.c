@@ -0,0 +1,62 @@
+/*
+ * Benchmark Hash Functions
+ *
+ * This measures the hash functions of c-stdaux over small keys, which
+ * dominate hash-table workloads, as well as a larger buffer for throughput.
+ * Every iteration hashes a different (but cache-resident) key, and the key
+ * length is hidden from the compiler.
+ */
+
+#include "bench.h"
+
+#define BENCH_HASH_KEYS 64
+
+typedef struct {
+        _Alignas(64) uint8_t data[BENCH_HASH_KEYS * 4096];
+        uint8_t key[16];
+        size_t size;
+} BenchHash;
+
+static void bench_c_hash64(void *ctx, size_t n) {
+        BenchHash *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                bench_escape(c_hash64(b->data + (i % BENCH_HASH_KEYS) * b->size, b->size, 0));
+}
+
+static void bench_c_siphash13(void *ctx, size_t n) {
+        BenchHash *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                bench_escape(c_siphash13(b->data + (i % BENCH_HASH_KEYS) * b->size, b->size, b->key));
+}
+
+static void bench_c_crc32c(void *ctx, size_t n) {
+        BenchHash *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                bench_escape(c_crc32c(0, b->data + (i % BENCH_HASH_KEYS) * b->size, b->size));
+}
+
+int main(void) {
+        static const size_t sizes[] = { 8, 16, 24, 32, 48, 64, 4096 };
+        static BenchHash b;
+        size_t i;
+
+        bench_fill(b.data, sizeof(b.data), 1);
+        bench_fill(b.key, sizeof(b.key), 2);
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                b.size = sizes[i];
+
+                bench_run("hash", "c_hash64", b.size, 0, bench_c_hash64, &b);
+                bench_run("hash", "c_siphash13", b.size, 0, bench_c_siphash13, &b);
+                bench_run("hash", "c_crc32c", b.size, 0, bench_c_crc32c, &b);
+        }
+
+        return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Benchmark Hash Maps
+ *
+ * This measures lookups in a hash map defined via C_DEFINE_HASHMAP(), compared
+ * to a classic chained hash table with one allocation per entry. Both use the
+ * same hash function and key set. Lookups of present and absent keys are
+ * measured separately, over a range of table sizes.
+ *
+ * Every operation looks up BENCH_MAP_LOOKUPS random keys. A short sequence of
+ * keys that is replayed over and over lets the branch predictor learn the
+ * chain walk of each lookup, which does not happen with real workloads. This
+ * case is measured separately as `find-hit-replay`, with only
+ * BENCH_MAP_REPLAY keys.
+ */
+
+#include "bench.h"
+
+#define BENCH_MAP_LOOKUPS (16 * 1024)
+#define BENCH_MAP_REPLAY 1024
+
+typedef struct BenchChainEntry BenchChainEntry;
+
+struct BenchChainEntry {
+        BenchChainEntry *next;
+        uint64_t key;
+        uint64_t value;
+};
+
+typedef struct {
+        BenchChainEntry **buckets;
+        size_t mask;
+} BenchChain;
+
+static uint64_t bench_map_hash(const uint64_t *key) {
+        uint64_t x = *key;
+
+        /* splitmix64 finalizer */
+        x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
+        return x ^ (x >> 31);
+}
+
+static bool bench_map_equal(const uint64_t *a, const uint64_t *b) {
+        return *a == *b;
+}
+
+C_DEFINE_HASHMAP(BenchMap, uint64_t, uint64_t, bench_map_hash, bench_map_equal);
+
+typedef struct {
+        BenchMap map;
+        BenchChain chain;
+        const uint64_t *keys;
+        size_t n_keys;
+        uint64_t hit[BENCH_MAP_LOOKUPS];
+        uint64_t miss[BENCH_MAP_LOOKUPS];
+} BenchHashmap;
+
+static void bench_chain_insert(BenchChain *c, uint64_t key, uint64_t value) {
+        BenchChainEntry *e;
+        size_t i;
+
+        e = malloc(sizeof(*e));
+        c_assert(e);
+
+        i = bench_map_hash(&key) & c->mask;
+        *e = (BenchChainEntry){ .next = c->buckets[i], .key = key, .value = value };
+        c->buckets[i] = e;
+}
+
+static uint64_t *bench_chain_find(BenchChain *c, uint64_t key) {
+        BenchChainEntry *e;
+
+        for (e = c->buckets[bench_map_hash(&key) & c->mask]; e; e = e->next)
+                if (e->key == key)
+                        return &e->value;
+
+        return NULL;
+}
+
+static void bench_chain_deinit(BenchChain *c) {
+        BenchChainEntry *e;
+        size_t i;
+
+        for (i = 0; i <= c->mask; ++i) {
+                while ((e = c->buckets[i])) {
+                        c->buckets[i] = e->next;
+                        free(e);
+                }
+        }
+
+        c->buckets = c_free(c->buckets);
+}
+
+static void bench_c_hashmap(void *ctx, size_t n) {
+        BenchHashmap *b = ctx;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i)
+                for (j = 0; j < b->n_keys; ++j)
+                        bench_escape(BenchMap_find(&b->map, &b->keys[j]));
+}
+
+static void bench_chain(void *ctx, size_t n) {
+        BenchHashmap *b = ctx;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i)
+                for (j = 0; j < b->n_keys; ++j)
+                        bench_escape(bench_chain_find(&b->chain, b->keys[j]));
+}
+
+static void bench_lookups(BenchHashmap *b,
+                          const char *benchmark,
+                          size_t size,
+                          const uint64_t *keys,
+                          size_t n_keys) {
+        b->keys = keys;
+        b->n_keys = n_keys;
+        bench_run(benchmark, "c_hashmap", size, 0, bench_c_hashmap, b);
+        bench_run(benchmark, "chained", size, 0, bench_chain, b);
+}
+
+int main(void) {
+        static const size_t sizes[] = { 1024, 65536, 1024 * 1024 };
+        static BenchHashmap b;
+        uint64_t state = 1;
+        size_t i, j;
+        int r;
+
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                /* even keys are inserted, odd keys are looked up as misses */
+                b.chain.mask = sizes[i] - 1;
+                b.chain.buckets = calloc(sizes[i], sizeof(*b.chain.buckets));
+                c_assert(b.chain.buckets);
+
+                for (j = 0; j < sizes[i]; ++j) {
+                        r = BenchMap_insert(&b.map, j * 2, j);
+                        c_assert(!r);
+                        bench_chain_insert(&b.chain, j * 2, j);
+                }
+
+                for (j = 0; j < BENCH_MAP_LOOKUPS; ++j) {
+                        b.hit[j] = (bench_random(&state) % sizes[i]) * 2;
+                        b.miss[j] = b.hit[j] + 1;
+                }
+
+                bench_lookups(&b, "find-hit", sizes[i], b.hit, BENCH_MAP_LOOKUPS);
+                bench_lookups(&b, "find-miss", sizes[i], b.miss, BENCH_MAP_LOOKUPS);
+                bench_lookups(&b, "find-hit-replay", sizes[i], b.hit, BENCH_MAP_REPLAY);
+
+                BenchMap_deinit(&b.map);
+                bench_chain_deinit(&b.chain);
+        }
+
+        return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Benchmark Full-Length I/O
+ *
+ * This writes batches of small records to `/dev/null`, once with one
+ * `write(2)` per record, and once with a single c_writev_full() per batch.
+ * Since `/dev/null` discards the data, this measures the system call
+ * overhead, which dominates small writes to pipes and sockets as well. The
+ * `size` column is the number of 64-byte records per batch, and the reported
+ * time is per batch.
+ */
+
+#include <fcntl.h>
+#include "bench.h"
+
+#define BENCH_IO_RECORD 64
+#define BENCH_IO_MAX 256
+
+typedef struct {
+        char records[BENCH_IO_MAX][BENCH_IO_RECORD];
+        struct iovec iov[BENCH_IO_MAX];
+        size_t n_records;
+        int fd;
+} BenchIO;
+
+static void bench_write(void *ctx, size_t n) {
+        BenchIO *b = ctx;
+        size_t i, j;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->n_records; ++j) {
+                        r = c_write_full(b->fd, b->records[j], BENCH_IO_RECORD, NULL);
+                        c_assert(!r);
+                }
+        }
+}
+
+static void bench_writev(void *ctx, size_t n) {
+        BenchIO *b = ctx;
+        size_t i, j;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->n_records; ++j) {
+                        b->iov[j].iov_base = b->records[j];
+                        b->iov[j].iov_len = BENCH_IO_RECORD;
+                }
+
+                r = c_writev_full(b->fd, b->iov, b->n_records, NULL);
+                c_assert(!r);
+        }
+}
+
+int main(void) {
+        static const size_t sizes[] = { 1, 4, 16, 64, BENCH_IO_MAX };
+        static BenchIO b;
+        size_t i;
+
+        b.fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+        c_assert(b.fd >= 0);
+        bench_fill(b.records, sizeof(b.records), 1);
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                b.n_records = sizes[i];
+
+                bench_run("write", "c_write_full", b.n_records, 0, bench_write, &b);
+                bench_run("write", "c_writev_full", b.n_records, 0, bench_writev, &b);
+        }
+
+        b.fd = c_close(b.fd);
+        return 0;
+}
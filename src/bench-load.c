@@ -0,0 +1,170 @@
+/*
+ * Benchmark Memory Access Helpers
+ *
+ * This compares the c_load_*() and c_store_*() helpers to a raw memcpy() of
+ * the native integer followed by a byte-swap builtin, for aligned and
+ * unaligned access. Furthermore, the c_load_*_array() helpers are compared to
+ * an open-coded loop over the scalar helpers.
+ */
+
+#include "bench.h"
+
+#define BENCH_LOAD_MAX (64 * 1024)
+
+typedef struct {
+        _Alignas(64) uint8_t src[BENCH_LOAD_MAX + 64];
+        _Alignas(64) uint8_t dst[BENCH_LOAD_MAX + 64];
+        size_t size;
+        size_t alignment;
+} BenchLoad;
+
+static void bench_c_load_32be(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        uint32_t sum = 0;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size; j += 4)
+                        sum += c_load_32be_unaligned(b->src + b->alignment, j);
+                bench_escape(sum);
+        }
+}
+
+static void bench_raw_load_32be(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        uint32_t v, sum = 0;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size; j += 4) {
+                        memcpy(&v, b->src + b->alignment + j, sizeof(v));
+                        sum += __builtin_bswap32(v);
+                }
+                bench_escape(sum);
+        }
+}
+
+static void bench_c_load_64be(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        uint64_t sum = 0;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size; j += 8)
+                        sum += c_load_64be_unaligned(b->src + b->alignment, j);
+                bench_escape(sum);
+        }
+}
+
+static void bench_raw_load_64be(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        uint64_t v, sum = 0;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size; j += 8) {
+                        memcpy(&v, b->src + b->alignment + j, sizeof(v));
+                        sum += __builtin_bswap64(v);
+                }
+                bench_escape(sum);
+        }
+}
+
+static void bench_c_store_64be(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size; j += 8)
+                        c_store_64be_unaligned(b->dst + b->alignment, j, i + j);
+                bench_clobber();
+        }
+}
+
+static void bench_raw_store_64be(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        uint64_t v;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size; j += 8) {
+                        v = __builtin_bswap64(i + j);
+                        memcpy(b->dst + b->alignment + j, &v, sizeof(v));
+                }
+                bench_clobber();
+        }
+}
+
+static void bench_c_load_32be_array(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                c_load_32be_array((uint32_t *)b->dst, b->src + b->alignment, b->size / 4);
+                bench_clobber();
+        }
+}
+
+static void bench_loop_load_32be_array(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        uint32_t *dst = (uint32_t *)b->dst;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size / 4; ++j)
+                        dst[j] = c_load_32be_unaligned(b->src + b->alignment, j * 4);
+                bench_clobber();
+        }
+}
+
+static void bench_c_load_64be_array(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                c_load_64be_array((uint64_t *)b->dst, b->src + b->alignment, b->size / 8);
+                bench_clobber();
+        }
+}
+
+static void bench_loop_load_64be_array(void *ctx, size_t n) {
+        BenchLoad *b = ctx;
+        uint64_t *dst = (uint64_t *)b->dst;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size / 8; ++j)
+                        dst[j] = c_load_64be_unaligned(b->src + b->alignment, j * 8);
+                bench_clobber();
+        }
+}
+
+int main(void) {
+        static const size_t sizes[] = { 64, 4096, BENCH_LOAD_MAX };
+        static const size_t alignments[] = { 0, 1 };
+        static BenchLoad b;
+        size_t i, j;
+
+        bench_fill(b.src, sizeof(b.src), 1);
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                for (j = 0; j < C_ARRAY_SIZE(alignments); ++j) {
+                        b.size = sizes[i];
+                        b.alignment = alignments[j];
+
+                        bench_run("load_32be", "c_load_32be_unaligned", b.size, b.alignment, bench_c_load_32be, &b);
+                        bench_run("load_32be", "memcpy+bswap32", b.size, b.alignment, bench_raw_load_32be, &b);
+                        bench_run("load_64be", "c_load_64be_unaligned", b.size, b.alignment, bench_c_load_64be, &b);
+                        bench_run("load_64be", "memcpy+bswap64", b.size, b.alignment, bench_raw_load_64be, &b);
+                        bench_run("store_64be", "c_store_64be_unaligned", b.size, b.alignment, bench_c_store_64be, &b);
+                        bench_run("store_64be", "bswap64+memcpy", b.size, b.alignment, bench_raw_store_64be, &b);
+                        bench_run("load_32be_array", "c_load_32be_array", b.size, b.alignment, bench_c_load_32be_array, &b);
+                        bench_run("load_32be_array", "loop", b.size, b.alignment, bench_loop_load_32be_array, &b);
+                        bench_run("load_64be_array", "c_load_64be_array", b.size, b.alignment, bench_c_load_64be_array, &b);
+                        bench_run("load_64be_array", "loop", b.size, b.alignment, bench_loop_load_64be_array, &b);
+                }
+        }
+
+        return 0;
+}
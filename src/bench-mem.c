@@ -0,0 +1,121 @@
+/*
+ * Benchmark Memory Helpers
+ *
+ * This compares c_memcpy(), c_memset(), c_memzero(), and c_memcmp() to their
+ * libc counterparts, over a range of sizes and misalignments. The sizes are
+ * hidden from the compiler, so this measures the runtime dispatch rather than
+ * the constant-size inlining.
+ */
+
+#include "bench.h"
+
+#define BENCH_MEM_MAX (64 * 1024)
+
+typedef struct {
+        _Alignas(64) uint8_t src[BENCH_MEM_MAX + 64];
+        _Alignas(64) uint8_t dst[BENCH_MEM_MAX + 64];
+        size_t size;
+        size_t alignment;
+} BenchMem;
+
+static void bench_c_memcpy(void *ctx, size_t n) {
+        BenchMem *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                c_memcpy(b->dst + b->alignment, b->src + b->alignment, b->size);
+                bench_clobber();
+        }
+}
+
+static void bench_memcpy(void *ctx, size_t n) {
+        BenchMem *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                memcpy(b->dst + b->alignment, b->src + b->alignment, b->size);
+                bench_clobber();
+        }
+}
+
+static void bench_c_memset(void *ctx, size_t n) {
+        BenchMem *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                c_memset(b->dst + b->alignment, (int)i, b->size);
+                bench_clobber();
+        }
+}
+
+static void bench_memset(void *ctx, size_t n) {
+        BenchMem *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                memset(b->dst + b->alignment, (int)i, b->size);
+                bench_clobber();
+        }
+}
+
+static void bench_c_memzero(void *ctx, size_t n) {
+        BenchMem *b = ctx;
+        size_t i;
+
+        for (i = 0; i < n; ++i) {
+                c_memzero(b->dst + b->alignment, b->size);
+                bench_clobber();
+        }
+}
+
+static void bench_c_memcmp(void *ctx, size_t n) {
+        BenchMem *b = ctx;
+        size_t i;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                r = c_memcmp(b->dst + b->alignment, b->src + b->alignment, b->size);
+                bench_escape(r);
+        }
+}
+
+static void bench_memcmp(void *ctx, size_t n) {
+        BenchMem *b = ctx;
+        size_t i;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                r = memcmp(b->dst + b->alignment, b->src + b->alignment, b->size);
+                bench_escape(r);
+        }
+}
+
+int main(void) {
+        static const size_t sizes[] = { 0, 8, 64, 256, 4096, BENCH_MEM_MAX };
+        static const size_t alignments[] = { 0, 1, 7 };
+        static BenchMem b;
+        size_t i, j;
+
+        bench_fill(b.src, sizeof(b.src), 1);
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                for (j = 0; j < C_ARRAY_SIZE(alignments); ++j) {
+                        b.size = sizes[i];
+                        b.alignment = alignments[j];
+
+                        bench_run("memcpy", "c_memcpy", b.size, b.alignment, bench_c_memcpy, &b);
+                        bench_run("memcpy", "memcpy", b.size, b.alignment, bench_memcpy, &b);
+                        bench_run("memset", "c_memset", b.size, b.alignment, bench_c_memset, &b);
+                        bench_run("memset", "memset", b.size, b.alignment, bench_memset, &b);
+                        bench_run("memset", "c_memzero", b.size, b.alignment, bench_c_memzero, &b);
+
+                        /* compare equal buffers to scan the entire range */
+                        memcpy(b.dst, b.src, sizeof(b.dst));
+                        bench_run("memcmp", "c_memcmp", b.size, b.alignment, bench_c_memcmp, &b);
+                        bench_run("memcmp", "memcmp", b.size, b.alignment, bench_memcmp, &b);
+                }
+        }
+
+        return 0;
+}
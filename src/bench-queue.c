@@ -0,0 +1,287 @@
+/*
+ * Benchmark Queues
+ *
+ * This measures the throughput of handing pointers from producer threads to
+ * consumer threads, via the lock-free queues of c-stdaux, and via a ring
+ * protected by a pthread mutex and condition variables as baseline. With the
+ * lock-free queues, both sides retry if the queue is full or empty, yielding
+ * the CPU on every failed attempt so the results remain meaningful on
+ * machines with few CPUs. The reported time is per transferred element.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include "bench.h"
+
+#define BENCH_QUEUE_CAPACITY 1024
+#define BENCH_QUEUE_BATCH 32
+#define BENCH_QUEUE_MAX_THREADS 8
+
+typedef struct {
+        pthread_mutex_t lock;
+        pthread_cond_t not_empty;
+        pthread_cond_t not_full;
+        void *slots[BENCH_QUEUE_CAPACITY];
+        size_t head;
+        size_t tail;
+} BenchMutexQueue;
+
+typedef struct {
+        CSpscRing *spsc;
+        CMpmcQueue *mpmc;
+        BenchMutexQueue mutex;
+        size_t n;
+        size_t n_threads;
+} BenchQueue;
+
+typedef struct {
+        BenchQueue *b;
+        size_t n;
+} BenchThread;
+
+static void *bench_spsc_producer(void *ctx) {
+        BenchQueue *b = ctx;
+        size_t i;
+
+        for (i = 1; i <= b->n; ++i)
+                while (!c_spsc_ring_push(b->spsc, (void *)(uintptr_t)i))
+                        sched_yield();
+
+        return NULL;
+}
+
+static void bench_spsc(void *ctx, size_t n) {
+        BenchQueue *b = ctx;
+        pthread_t thread;
+        size_t i;
+        void *p;
+        int r;
+
+        b->n = n;
+        r = pthread_create(&thread, NULL, bench_spsc_producer, b);
+        c_assert(!r);
+
+        for (i = 1; i <= n; ++i) {
+                while (!c_spsc_ring_pop(b->spsc, &p))
+                        sched_yield();
+                c_assert(p == (void *)(uintptr_t)i);
+        }
+
+        r = pthread_join(thread, NULL);
+        c_assert(!r);
+}
+
+static void *bench_spsc_batch_producer(void *ctx) {
+        void *items[BENCH_QUEUE_BATCH];
+        BenchQueue *b = ctx;
+        size_t i, j, k, l;
+
+        for (i = 0; i < b->n; i += j) {
+                j = c_min(b->n - i, (size_t)BENCH_QUEUE_BATCH);
+                for (k = 0; k < j; ++k)
+                        items[k] = (void *)(uintptr_t)(i + k + 1);
+                for (k = 0; k < j; k += l)
+                        if (!(l = c_spsc_ring_push_n(b->spsc, items + k, j - k)))
+                                sched_yield();
+        }
+
+        return NULL;
+}
+
+static void bench_spsc_batch(void *ctx, size_t n) {
+        void *items[BENCH_QUEUE_BATCH];
+        BenchQueue *b = ctx;
+        pthread_t thread;
+        size_t i, j, k;
+        int r;
+
+        b->n = n;
+        r = pthread_create(&thread, NULL, bench_spsc_batch_producer, b);
+        c_assert(!r);
+
+        for (i = 0; i < n; i += j) {
+                j = c_spsc_ring_pop_n(b->spsc, items, BENCH_QUEUE_BATCH);
+                if (!j)
+                        sched_yield();
+                for (k = 0; k < j; ++k)
+                        c_assert(items[k] == (void *)(uintptr_t)(i + k + 1));
+        }
+
+        r = pthread_join(thread, NULL);
+        c_assert(!r);
+}
+
+static void bench_mutex_push(BenchMutexQueue *q, void *p) {
+        pthread_mutex_lock(&q->lock);
+        while (q->head - q->tail >= BENCH_QUEUE_CAPACITY)
+                pthread_cond_wait(&q->not_full, &q->lock);
+        q->slots[q->head++ % BENCH_QUEUE_CAPACITY] = p;
+        pthread_cond_signal(&q->not_empty);
+        pthread_mutex_unlock(&q->lock);
+}
+
+static void *bench_mutex_pop(BenchMutexQueue *q) {
+        void *p;
+
+        pthread_mutex_lock(&q->lock);
+        while (q->head == q->tail)
+                pthread_cond_wait(&q->not_empty, &q->lock);
+        p = q->slots[q->tail++ % BENCH_QUEUE_CAPACITY];
+        pthread_cond_signal(&q->not_full);
+        pthread_mutex_unlock(&q->lock);
+
+        return p;
+}
+
+static void *bench_mutex_producer(void *ctx) {
+        BenchQueue *b = ctx;
+        size_t i;
+
+        for (i = 1; i <= b->n; ++i)
+                bench_mutex_push(&b->mutex, (void *)(uintptr_t)i);
+
+        return NULL;
+}
+
+static void bench_mutex(void *ctx, size_t n) {
+        BenchQueue *b = ctx;
+        pthread_t thread;
+        size_t i;
+        void *p;
+        int r;
+
+        b->n = n;
+        r = pthread_create(&thread, NULL, bench_mutex_producer, b);
+        c_assert(!r);
+
+        for (i = 1; i <= n; ++i) {
+                p = bench_mutex_pop(&b->mutex);
+                c_assert(p == (void *)(uintptr_t)i);
+        }
+
+        r = pthread_join(thread, NULL);
+        c_assert(!r);
+}
+
+/*
+ * The MPMC benchmarks run `n_threads` producers and as many consumers, and
+ * split the elements evenly between them. Each thread transfers a fixed
+ * number of elements, so no termination protocol is needed.
+ */
+
+static size_t bench_share(size_t n, size_t n_threads, size_t i) {
+        return n / n_threads + (i < n % n_threads);
+}
+
+static void *bench_mpmc_producer(void *ctx) {
+        BenchThread *t = ctx;
+        size_t i;
+
+        for (i = 1; i <= t->n; ++i)
+                while (!c_mpmc_queue_push(t->b->mpmc, (void *)(uintptr_t)i))
+                        sched_yield();
+
+        return NULL;
+}
+
+static void *bench_mpmc_consumer(void *ctx) {
+        BenchThread *t = ctx;
+        size_t i;
+        void *p;
+
+        for (i = 0; i < t->n; ++i) {
+                while (!c_mpmc_queue_pop(t->b->mpmc, &p))
+                        sched_yield();
+                bench_escape(p);
+        }
+
+        return NULL;
+}
+
+static void *bench_mpmc_mutex_producer(void *ctx) {
+        BenchThread *t = ctx;
+        size_t i;
+
+        for (i = 1; i <= t->n; ++i)
+                bench_mutex_push(&t->b->mutex, (void *)(uintptr_t)i);
+
+        return NULL;
+}
+
+static void *bench_mpmc_mutex_consumer(void *ctx) {
+        BenchThread *t = ctx;
+        size_t i;
+
+        for (i = 0; i < t->n; ++i)
+                bench_escape(bench_mutex_pop(&t->b->mutex));
+
+        return NULL;
+}
+
+static void bench_mpmc_run(BenchQueue *b,
+                           size_t n,
+                           void *(*producer)(void *),
+                           void *(*consumer)(void *)) {
+        pthread_t threads[2 * BENCH_QUEUE_MAX_THREADS];
+        BenchThread ctx[2 * BENCH_QUEUE_MAX_THREADS];
+        size_t i;
+        int r;
+
+        for (i = 0; i < b->n_threads; ++i) {
+                ctx[2 * i] = (BenchThread){ .b = b, .n = bench_share(n, b->n_threads, i) };
+                ctx[2 * i + 1] = ctx[2 * i];
+                r = pthread_create(&threads[2 * i], NULL, producer, &ctx[2 * i]);
+                c_assert(!r);
+                r = pthread_create(&threads[2 * i + 1], NULL, consumer, &ctx[2 * i + 1]);
+                c_assert(!r);
+        }
+
+        for (i = 0; i < 2 * b->n_threads; ++i) {
+                r = pthread_join(threads[i], NULL);
+                c_assert(!r);
+        }
+}
+
+static void bench_mpmc(void *ctx, size_t n) {
+        bench_mpmc_run(ctx, n, bench_mpmc_producer, bench_mpmc_consumer);
+}
+
+static void bench_mpmc_mutex(void *ctx, size_t n) {
+        bench_mpmc_run(ctx, n, bench_mpmc_mutex_producer, bench_mpmc_mutex_consumer);
+}
+
+int main(void) {
+        static BenchQueue b;
+        size_t i;
+        int r;
+
+        r = c_spsc_ring_new(&b.spsc, BENCH_QUEUE_CAPACITY);
+        c_assert(!r);
+        r = c_mpmc_queue_new(&b.mpmc, BENCH_QUEUE_CAPACITY);
+        c_assert(!r);
+        r = pthread_mutex_init(&b.mutex.lock, NULL);
+        c_assert(!r);
+        r = pthread_cond_init(&b.mutex.not_empty, NULL);
+        c_assert(!r);
+        r = pthread_cond_init(&b.mutex.not_full, NULL);
+        c_assert(!r);
+
+        bench_header();
+        bench_run("spsc", "c_spsc_ring", 1, 0, bench_spsc, &b);
+        bench_run("spsc", "c_spsc_ring_batch", BENCH_QUEUE_BATCH, 0, bench_spsc_batch, &b);
+        bench_run("spsc", "mutex", 1, 0, bench_mutex, &b);
+
+        /* `size` is the number of producers (and consumers) here */
+        for (i = 1; i <= BENCH_QUEUE_MAX_THREADS; i *= 2) {
+                b.n_threads = i;
+                bench_run("mpmc", "c_mpmc_queue", i, 0, bench_mpmc, &b);
+                bench_run("mpmc", "mutex", i, 0, bench_mpmc_mutex, &b);
+        }
+
+        pthread_cond_destroy(&b.mutex.not_full);
+        pthread_cond_destroy(&b.mutex.not_empty);
+        pthread_mutex_destroy(&b.mutex.lock);
+        b.mpmc = c_mpmc_queue_free(b.mpmc);
+        b.spsc = c_spsc_ring_free(b.spsc);
+        return 0;
+}
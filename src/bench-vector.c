@@ -0,0 +1,105 @@
+/*
+ * Benchmark Vectors
+ *
+ * This measures appending elements to a vector defined via C_DEFINE_VECTOR(),
+ * compared to growing an array by one element per realloc(3), and to writing
+ * into a preallocated array (the lower bound). Each iteration builds a vector
+ * of the given size from scratch and releases it again.
+ */
+
+#include "bench.h"
+
+C_DEFINE_VECTOR(BenchVector, uint64_t);
+
+typedef struct {
+        uint64_t *array;
+        size_t size;
+} BenchVec;
+
+static void bench_c_vector(void *ctx, size_t n) {
+        BenchVec *b = ctx;
+        size_t i, j;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                BenchVector v = { 0 };
+
+                for (j = 0; j < b->size; ++j) {
+                        r = BenchVector_push(&v, j);
+                        c_assert(!r);
+                }
+                bench_escape(v.data);
+                BenchVector_deinit(&v);
+        }
+}
+
+static void bench_c_vector_reserve(void *ctx, size_t n) {
+        BenchVec *b = ctx;
+        size_t i, j;
+        int r;
+
+        for (i = 0; i < n; ++i) {
+                BenchVector v = { 0 };
+
+                r = BenchVector_reserve(&v, b->size);
+                c_assert(!r);
+                for (j = 0; j < b->size; ++j) {
+                        r = BenchVector_push(&v, j);
+                        c_assert(!r);
+                }
+                bench_escape(v.data);
+                BenchVector_deinit(&v);
+        }
+}
+
+static void bench_realloc(void *ctx, size_t n) {
+        BenchVec *b = ctx;
+        uint64_t *p, *data;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                data = NULL;
+                for (j = 0; j < b->size; ++j) {
+                        p = realloc(data, (j + 1) * sizeof(*data));
+                        c_assert(p);
+                        data = p;
+                        data[j] = j;
+                }
+                bench_escape(data);
+                free(data);
+        }
+}
+
+static void bench_array(void *ctx, size_t n) {
+        BenchVec *b = ctx;
+        size_t i, j;
+
+        for (i = 0; i < n; ++i) {
+                for (j = 0; j < b->size; ++j)
+                        b->array[j] = j;
+                bench_clobber();
+        }
+}
+
+int main(void) {
+        static const size_t sizes[] = { 16, 1024, 65536 };
+        BenchVec b = { 0 };
+        size_t i;
+
+        b.array = malloc(sizes[C_ARRAY_SIZE(sizes) - 1] * sizeof(*b.array));
+        c_assert(b.array);
+
+        bench_header();
+
+        for (i = 0; i < C_ARRAY_SIZE(sizes); ++i) {
+                b.size = sizes[i];
+
+                bench_run("push", "c_vector", b.size, 0, bench_c_vector, &b);
+                bench_run("push", "c_vector_reserve", b.size, 0, bench_c_vector_reserve, &b);
+                bench_run("push", "realloc", b.size, 0, bench_realloc, &b);
+                bench_run("push", "array", b.size, 0, bench_array, &b);
+        }
+
+        b.array = c_free(b.array);
+        return 0;
+}
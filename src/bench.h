@@ -0,0 +1,100 @@
+#pragma once
+
+/*
+ * Benchmark Helpers
+ *
+ * This is a small set of helpers shared by all `bench-*` executables. Each
+ * benchmark prints its results as CSV to stdout, one line per measurement,
+ * with the following columns:
+ *
+ *     benchmark,variant,size,alignment,iterations,ns_per_op
+ *
+ * `benchmark` names the measured operation, `variant` names the
+ * implementation (usually a c-stdaux helper and its raw libc or builtin
+ * equivalent), `size` and `alignment` describe the input (0 if not
+ * applicable), and `ns_per_op` is the average time of a single operation.
+ *
+ * Every measurement is calibrated to run for at least BENCH_MIN_NSEC, and
+ * the best of BENCH_ROUNDS rounds is reported.
+ */
+
+#undef NDEBUG
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "c-stdaux.h"
+
+#define BENCH_MIN_NSEC (UINT64_C(10) * 1000 * 1000)
+#define BENCH_ROUNDS 3
+
+typedef void (*BenchFn) (void *ctx, size_t n_iterations);
+
+/*
+ * Hide a value or memory from the optimizer, so computations of the
+ * benchmark are not optimized away.
+ */
+#define bench_escape(_x) __asm__ __volatile__("" : : "g"(_x) : "memory")
+#define bench_clobber() __asm__ __volatile__("" : : : "memory")
+
+static inline uint64_t bench_now(void) {
+        struct timespec ts;
+        int r;
+
+        r = clock_gettime(CLOCK_MONOTONIC, &ts);
+        c_assert(!r);
+
+        return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t bench_random(uint64_t *state) {
+        /* xorshift64*, good enough for benchmark input */
+        *state ^= *state >> 12;
+        *state ^= *state << 25;
+        *state ^= *state >> 27;
+        return *state * UINT64_C(2685821657736338717);
+}
+
+static inline void bench_fill(void *p, size_t n, uint64_t seed) {
+        uint8_t *m = p;
+        size_t i;
+
+        for (i = 0; i < n; ++i)
+                m[i] = (uint8_t)bench_random(&seed);
+}
+
+static inline void bench_header(void) {
+        printf("benchmark,variant,size,alignment,iterations,ns_per_op\n");
+}
+
+static inline void bench_run(const char *benchmark,
+                             const char *variant,
+                             size_t size,
+                             size_t alignment,
+                             BenchFn fn,
+                             void *ctx) {
+        uint64_t n = 1, ts, nsec, best = UINT64_MAX;
+        size_t i;
+
+        /* find an iteration count that runs long enough */
+        for (;;) {
+                ts = bench_now();
+                fn(ctx, n);
+                nsec = bench_now() - ts;
+                if (nsec >= BENCH_MIN_NSEC)
+                        break;
+
+                n *= nsec ? c_clamp(BENCH_MIN_NSEC / nsec + 1, 2, 1024) : 1024;
+        }
+
+        best = nsec;
+        for (i = 1; i < BENCH_ROUNDS; ++i) {
+                ts = bench_now();
+                fn(ctx, n);
+                nsec = bench_now() - ts;
+                best = c_min(best, nsec);
+        }
+
+        printf("%s,%s,%zu,%zu,%" PRIu64 ",%.3f\n",
+               benchmark, variant, size, alignment, n, (double)best / (double)n);
+        fflush(stdout);
+}
@@ -0,0 +1,621 @@
+#pragma once
+
+/*
+ * c-stdaux-atomic: Atomic operations
+ *
+ * This header contains atomic memory operations with explicit memory ordering.
+ * They are based on the atomic builtins of GNUC-compatible compilers.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <c-stdaux-generic.h>
+#include <c-stdaux-gnuc.h>
+
+/* Documented alongside target properties. */
+#define C_MODULE_ATOMIC 1
+
+/**
+ * DOC: Atomic Operations
+ *
+ * A set of type-generic atomic operations is provided, which map to the
+ * ``__atomic_*()`` builtins of GNUC-compatible compilers. They operate on
+ * plain integer and pointer objects (i.e., no ``_Atomic`` qualifier is
+ * required), as long as the object is naturally aligned and lock-free atomic
+ * access is supported for its size.
+ *
+ * Every operation takes an explicit memory order, which must be one of:
+ *
+ * - ``C_ATOMIC_RELAXED``: No ordering constraints, only atomicity.
+ * - ``C_ATOMIC_ACQUIRE``: Subsequent memory accesses cannot be reordered
+ *   before this operation. Only valid for operations that read.
+ * - ``C_ATOMIC_RELEASE``: Preceding memory accesses cannot be reordered after
+ *   this operation. Only valid for operations that write.
+ * - ``C_ATOMIC_ACQ_REL``: Both of the above. Only valid for
+ *   read-modify-write operations.
+ * - ``C_ATOMIC_SEQ_CST``: Like ``C_ATOMIC_ACQ_REL``, and additionally a
+ *   single total order exists for all sequentially-consistent operations.
+ *
+ * The memory order must be a constant expression. It is verified at compile
+ * time to be valid for the respective operation, so a misuse is caught
+ * before it silently degrades to sequential consistency. Sequential
+ * consistency is rarely needed, and usually comes at the cost of a full
+ * memory barrier. Prefer acquire/release pairs and relaxed operations
+ * wherever possible.
+ */
+/**/
+
+#define C_ATOMIC_RELAXED __ATOMIC_RELAXED
+#define C_ATOMIC_ACQUIRE __ATOMIC_ACQUIRE
+#define C_ATOMIC_RELEASE __ATOMIC_RELEASE
+#define C_ATOMIC_ACQ_REL __ATOMIC_ACQ_REL
+#define C_ATOMIC_SEQ_CST __ATOMIC_SEQ_CST
+
+#define C_INTERNAL_ATOMIC_ORDER_READ(_order)                                    \
+        ((_order) == C_ATOMIC_RELAXED ||                                        \
+         (_order) == C_ATOMIC_ACQUIRE ||                                        \
+         (_order) == C_ATOMIC_SEQ_CST)
+#define C_INTERNAL_ATOMIC_ORDER_WRITE(_order)                                   \
+        ((_order) == C_ATOMIC_RELAXED ||                                        \
+         (_order) == C_ATOMIC_RELEASE ||                                        \
+         (_order) == C_ATOMIC_SEQ_CST)
+#define C_INTERNAL_ATOMIC_ORDER_RMW(_order)                                     \
+        (C_INTERNAL_ATOMIC_ORDER_READ(_order) ||                                \
+         (_order) == C_ATOMIC_RELEASE ||                                        \
+         (_order) == C_ATOMIC_ACQ_REL)
+
+/**
+ * c_atomic_load() - Atomically read an object
+ * @_ptr:       Pointer to the object to read
+ * @_order:     Memory order, must not be a release order
+ *
+ * Return: The value of the object is returned.
+ */
+#define c_atomic_load(_ptr, _order)                                             \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_load_n((_ptr), (_order)),                              \
+                C_INTERNAL_ATOMIC_ORDER_READ(_order),                           \
+                "Invalid memory order for c_atomic_load()"                      \
+        )
+
+/**
+ * c_atomic_store() - Atomically write an object
+ * @_ptr:       Pointer to the object to write
+ * @_value:     Value to write
+ * @_order:     Memory order, must not be an acquire order
+ */
+#define c_atomic_store(_ptr, _value, _order)                                    \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_store_n((_ptr), (_value), (_order)),                   \
+                C_INTERNAL_ATOMIC_ORDER_WRITE(_order),                          \
+                "Invalid memory order for c_atomic_store()"                     \
+        )
+
+/**
+ * c_atomic_xchg() - Atomically exchange the value of an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_value:     Value to write
+ * @_order:     Memory order
+ *
+ * Return: The previous value of the object is returned.
+ */
+#define c_atomic_xchg(_ptr, _value, _order)                                     \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_exchange_n((_ptr), (_value), (_order)),                \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_order),                            \
+                "Invalid memory order for c_atomic_xchg()"                      \
+        )
+
+/**
+ * c_atomic_cmpxchg() - Atomically compare and exchange an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_expected:  Pointer to the expected value
+ * @_desired:   Value to write
+ * @_success:   Memory order on success
+ * @_failure:   Memory order on failure, must not be a release order
+ *
+ * This compares the value of the object with ``*_expected``. If equal,
+ * ``_desired`` is written to the object. Otherwise, the current value of the
+ * object is written to ``*_expected``.
+ *
+ * The failure order must not be stronger than the success order.
+ *
+ * Return: True if ``_desired`` was written, false otherwise.
+ */
+#define c_atomic_cmpxchg(_ptr, _expected, _desired, _success, _failure)         \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_compare_exchange_n((_ptr),                             \
+                                            (_expected),                        \
+                                            (_desired),                         \
+                                            false,                              \
+                                            (_success),                         \
+                                            (_failure)),                        \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_success) &&                        \
+                C_INTERNAL_ATOMIC_ORDER_READ(_failure) &&                       \
+                (_failure) <= (_success),                                       \
+                "Invalid memory order for c_atomic_cmpxchg()"                   \
+        )
+
+/**
+ * c_atomic_cmpxchg_weak() - Atomically compare and exchange an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_expected:  Pointer to the expected value
+ * @_desired:   Value to write
+ * @_success:   Memory order on success
+ * @_failure:   Memory order on failure, must not be a release order
+ *
+ * This works like :c:macro:`c_atomic_cmpxchg()`, but might fail spuriously
+ * even if the values are equal. On some architectures, this is cheaper if the
+ * operation is retried in a loop, anyway.
+ *
+ * Return: True if ``_desired`` was written, false otherwise.
+ */
+#define c_atomic_cmpxchg_weak(_ptr, _expected, _desired, _success, _failure)    \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_compare_exchange_n((_ptr),                             \
+                                            (_expected),                        \
+                                            (_desired),                         \
+                                            true,                               \
+                                            (_success),                         \
+                                            (_failure)),                        \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_success) &&                        \
+                C_INTERNAL_ATOMIC_ORDER_READ(_failure) &&                       \
+                (_failure) <= (_success),                                       \
+                "Invalid memory order for c_atomic_cmpxchg_weak()"              \
+        )
+
+/**
+ * c_atomic_fetch_add() - Atomically add to an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_value:     Value to add
+ * @_order:     Memory order
+ *
+ * Return: The previous value of the object is returned.
+ */
+#define c_atomic_fetch_add(_ptr, _value, _order)                                \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_fetch_add((_ptr), (_value), (_order)),                 \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_order),                            \
+                "Invalid memory order for c_atomic_fetch_add()"                 \
+        )
+
+/**
+ * c_atomic_fetch_sub() - Atomically subtract from an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_value:     Value to subtract
+ * @_order:     Memory order
+ *
+ * Return: The previous value of the object is returned.
+ */
+#define c_atomic_fetch_sub(_ptr, _value, _order)                                \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_fetch_sub((_ptr), (_value), (_order)),                 \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_order),                            \
+                "Invalid memory order for c_atomic_fetch_sub()"                 \
+        )
+
+/**
+ * c_atomic_fetch_and() - Atomically bitwise-AND an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_value:     Mask to apply
+ * @_order:     Memory order
+ *
+ * Return: The previous value of the object is returned.
+ */
+#define c_atomic_fetch_and(_ptr, _value, _order)                                \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_fetch_and((_ptr), (_value), (_order)),                 \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_order),                            \
+                "Invalid memory order for c_atomic_fetch_and()"                 \
+        )
+
+/**
+ * c_atomic_fetch_or() - Atomically bitwise-OR an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_value:     Mask to apply
+ * @_order:     Memory order
+ *
+ * Return: The previous value of the object is returned.
+ */
+#define c_atomic_fetch_or(_ptr, _value, _order)                                 \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_fetch_or((_ptr), (_value), (_order)),                  \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_order),                            \
+                "Invalid memory order for c_atomic_fetch_or()"                  \
+        )
+
+/**
+ * c_atomic_fetch_xor() - Atomically bitwise-XOR an object
+ * @_ptr:       Pointer to the object to operate on
+ * @_value:     Mask to apply
+ * @_order:     Memory order
+ *
+ * Return: The previous value of the object is returned.
+ */
+#define c_atomic_fetch_xor(_ptr, _value, _order)                                \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_fetch_xor((_ptr), (_value), (_order)),                 \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_order),                            \
+                "Invalid memory order for c_atomic_fetch_xor()"                 \
+        )
+
+/**
+ * c_atomic_fence() - Memory fence
+ * @_order:     Memory order, must not be relaxed
+ *
+ * Issue a memory fence with the given memory order. This synchronizes with
+ * other fences and atomic operations like the atomic operations themselves,
+ * but is not bound to a specific object.
+ */
+#define c_atomic_fence(_order)                                                  \
+        C_EXPR_ASSERT(                                                          \
+                __atomic_thread_fence(_order),                                  \
+                (_order) != C_ATOMIC_RELAXED &&                                 \
+                C_INTERNAL_ATOMIC_ORDER_RMW(_order),                            \
+                "Invalid memory order for c_atomic_fence()"                     \
+        )
+
+/**
+ * DOC: Single-Producer/Single-Consumer Rings
+ *
+ * A :c:struct:`CSpscRing` is a bounded, lock-free FIFO queue of pointers for
+ * exactly one producer thread and exactly one consumer thread. Neither side
+ * ever blocks or retries: if the ring is full (or empty), the operation fails
+ * immediately and the caller decides how to wait.
+ *
+ * The producer and consumer indices live on separate cache lines, apart from
+ * the read-only capacity and the slots themselves. Each side keeps a private
+ * copy of the index of the other side. The shared index of the other side is
+ * only read (with acquire semantics) if the private copy suggests the ring is
+ * full (or empty). Thus, in steady state, the cache lines of the indices are
+ * not bounced between the cores, and stores to the slots never invalidate
+ * the line of the capacity. Batch operations amortize the release store of
+ * the index over many elements.
+ */
+/**/
+
+/**
+ * struct CSpscRing - Single-producer/single-consumer ring
+ * @head:               Producer index, written by the producer only
+ * @cached_tail:        Producer copy of @tail
+ * @tail:               Consumer index, written by the consumer only
+ * @cached_head:        Consumer copy of @head
+ * @mask:               Capacity minus 1, never written after creation
+ * @slots:              Ring buffer, starting on its own cache line
+ *
+ * This is the object backing a single-producer/single-consumer ring. It is
+ * created via :c:func:`c_spsc_ring_new()`. All members are private to the
+ * implementation.
+ */
+typedef struct CSpscRing {
+        _c_cacheline_aligned_ size_t head;
+        size_t cached_tail;
+        _c_cacheline_aligned_ size_t tail;
+        size_t cached_head;
+        _c_cacheline_aligned_ size_t mask;
+        _c_cacheline_aligned_ void *slots[];
+} CSpscRing;
+
+/**
+ * c_spsc_ring_new() - Create single-producer/single-consumer ring
+ * @ringp:              Output argument for the new ring
+ * @capacity:           Minimum number of elements the ring can hold
+ *
+ * Create a new, empty ring that can hold at least ``capacity`` elements. The
+ * capacity is rounded up to the next power of 2.
+ *
+ * Return: 0 on success, ``-ENOMEM`` if out of memory or if the capacity
+ *         cannot be represented.
+ */
+static inline int c_spsc_ring_new(CSpscRing **ringp, size_t capacity) {
+        CSpscRing *ring;
+        size_t n;
+
+        capacity = c_next_pow2(capacity);
+        if (!capacity ||
+            c_mul_overflow(capacity, sizeof(void *), &n) ||
+            c_add_overflow(n, sizeof(*ring), &n) ||
+            n > SIZE_MAX - C_CACHELINE_SIZE)
+                return -ENOMEM;
+
+        ring = aligned_alloc(C_CACHELINE_SIZE, c_align_to(n, C_CACHELINE_SIZE));
+        if (!ring)
+                return -ENOMEM;
+
+        ring->head = 0;
+        ring->cached_tail = 0;
+        ring->tail = 0;
+        ring->cached_head = 0;
+        ring->mask = capacity - 1;
+
+        *ringp = ring;
+        return 0;
+}
+
+/**
+ * c_spsc_ring_free() - Destroy single-producer/single-consumer ring
+ * @ring:               Ring to destroy, or NULL
+ *
+ * Destroy ``ring``. Elements still queued are not touched. If ``ring`` is
+ * NULL, this is a no-op.
+ *
+ * Return: NULL is returned.
+ */
+static inline CSpscRing *c_spsc_ring_free(CSpscRing *ring) {
+        free(ring);
+        return NULL;
+}
+
+/**
+ * c_spsc_ring_push_n() - Enqueue elements
+ * @ring:               Ring to operate on
+ * @items:              Elements to enqueue
+ * @n:                  Number of elements to enqueue
+ *
+ * Enqueue up to ``n`` elements from ``items``, in order, as far as space is
+ * available. They become visible to the consumer at once. This must only be
+ * called by the producer.
+ *
+ * Return: The number of elements enqueued is returned.
+ */
+static inline size_t c_spsc_ring_push_n(CSpscRing *ring, void *const *items, size_t n) {
+        size_t i, head;
+
+        head = c_atomic_load(&ring->head, C_ATOMIC_RELAXED);
+        if (_c_unlikely_(ring->mask + 1 - (head - ring->cached_tail) < n)) {
+                ring->cached_tail = c_atomic_load(&ring->tail, C_ATOMIC_ACQUIRE);
+                n = c_min(n, ring->mask + 1 - (head - ring->cached_tail));
+        }
+
+        for (i = 0; i < n; ++i)
+                ring->slots[(head + i) & ring->mask] = items[i];
+
+        c_atomic_store(&ring->head, head + n, C_ATOMIC_RELEASE);
+        return n;
+}
+
+/**
+ * c_spsc_ring_push() - Enqueue element
+ * @ring:               Ring to operate on
+ * @item:               Element to enqueue
+ *
+ * Enqueue a single element. This must only be called by the producer.
+ *
+ * Return: True if the element was enqueued, false if the ring is full.
+ */
+static inline bool c_spsc_ring_push(CSpscRing *ring, void *item) {
+        return c_spsc_ring_push_n(ring, &item, 1);
+}
+
+/**
+ * c_spsc_ring_pop_n() - Dequeue elements
+ * @ring:               Ring to operate on
+ * @items:              Output array for the dequeued elements
+ * @n:                  Maximum number of elements to dequeue
+ *
+ * Dequeue up to ``n`` elements into ``items``, in order, as far as elements
+ * are available. This must only be called by the consumer.
+ *
+ * Return: The number of elements dequeued is returned.
+ */
+static inline size_t c_spsc_ring_pop_n(CSpscRing *ring, void **items, size_t n) {
+        size_t i, tail;
+
+        tail = c_atomic_load(&ring->tail, C_ATOMIC_RELAXED);
+        if (_c_unlikely_(ring->cached_head - tail < n)) {
+                ring->cached_head = c_atomic_load(&ring->head, C_ATOMIC_ACQUIRE);
+                n = c_min(n, ring->cached_head - tail);
+        }
+
+        for (i = 0; i < n; ++i)
+                items[i] = ring->slots[(tail + i) & ring->mask];
+
+        c_atomic_store(&ring->tail, tail + n, C_ATOMIC_RELEASE);
+        return n;
+}
+
+/**
+ * c_spsc_ring_pop() - Dequeue element
+ * @ring:               Ring to operate on
+ * @itemp:              Output argument for the dequeued element
+ *
+ * Dequeue a single element. This must only be called by the consumer.
+ *
+ * Return: True if an element was dequeued, false if the ring is empty.
+ */
+static inline bool c_spsc_ring_pop(CSpscRing *ring, void **itemp) {
+        return c_spsc_ring_pop_n(ring, itemp, 1);
+}
+
+C_DEFINE_CLEANUP(CSpscRing *, c_spsc_ring_free);
+
+/**
+ * DOC: Multi-Producer/Multi-Consumer Queues
+ *
+ * A :c:struct:`CMpmcQueue` is a bounded, lock-free FIFO queue of pointers for
+ * any number of producer and consumer threads. Like the SPSC ring, operations
+ * never block: if the queue is full (or empty), they fail immediately.
+ *
+ * The implementation follows the design of Dmitry Vyukov: every cell carries
+ * a sequence number, which tells whether the cell is ready to be written for
+ * a given producer position, or ready to be read for a given consumer
+ * position. Producers (and consumers) claim a position via a
+ * compare-and-exchange on their shared index, and then hand over the cell
+ * with a release store of its sequence number. Thus, producers only contend
+ * with producers, and consumers only with consumers. Each cell occupies its
+ * own cache line, so neighboring cells accessed by different threads do not
+ * share a line.
+ */
+/**/
+
+/**
+ * struct CMpmcQueueCell - Cell of a multi-producer/multi-consumer queue
+ * @sequence:           Sequence number of the cell
+ * @item:               Stored element
+ *
+ * This is the cache-line sized slot of a :c:struct:`CMpmcQueue`. All members
+ * are private to the implementation.
+ */
+typedef struct CMpmcQueueCell {
+        _c_cacheline_aligned_ size_t sequence;
+        void *item;
+} CMpmcQueueCell;
+
+/**
+ * struct CMpmcQueue - Multi-producer/multi-consumer queue
+ * @head:               Producer index, shared by all producers
+ * @tail:               Consumer index, shared by all consumers
+ * @mask:               Capacity minus 1
+ * @cells:              Ring buffer
+ *
+ * This is the object backing a multi-producer/multi-consumer queue. It is
+ * created via :c:func:`c_mpmc_queue_new()`. All members are private to the
+ * implementation.
+ */
+typedef struct CMpmcQueue {
+        _c_cacheline_aligned_ size_t head;
+        _c_cacheline_aligned_ size_t tail;
+        _c_cacheline_aligned_ size_t mask;
+        CMpmcQueueCell cells[];
+} CMpmcQueue;
+
+/**
+ * c_mpmc_queue_new() - Create multi-producer/multi-consumer queue
+ * @queuep:             Output argument for the new queue
+ * @capacity:           Minimum number of elements the queue can hold
+ *
+ * Create a new, empty queue that can hold at least ``capacity`` elements. The
+ * capacity is rounded up to the next power of 2, but is at least 2.
+ *
+ * Return: 0 on success, ``-ENOMEM`` if out of memory or if the capacity
+ *         cannot be represented.
+ */
+static inline int c_mpmc_queue_new(CMpmcQueue **queuep, size_t capacity) {
+        CMpmcQueue *queue;
+        size_t i, n;
+
+        /*
+         * A single cell cannot tell a written cell from a freed one, since
+         * both sequence numbers would be equal. Hence, use at least 2.
+         */
+        capacity = c_next_pow2(c_max(capacity, (size_t)2));
+        if (!capacity ||
+            capacity > SIZE_MAX / 2 ||
+            c_mul_overflow(capacity, sizeof(CMpmcQueueCell), &n) ||
+            c_add_overflow(n, sizeof(*queue), &n))
+                return -ENOMEM;
+
+        queue = aligned_alloc(C_CACHELINE_SIZE, n);
+        if (!queue)
+                return -ENOMEM;
+
+        queue->head = 0;
+        queue->tail = 0;
+        queue->mask = capacity - 1;
+        for (i = 0; i < capacity; ++i)
+                queue->cells[i].sequence = i;
+
+        *queuep = queue;
+        return 0;
+}
+
+/**
+ * c_mpmc_queue_free() - Destroy multi-producer/multi-consumer queue
+ * @queue:              Queue to destroy, or NULL
+ *
+ * Destroy ``queue``. Elements still queued are not touched. The caller must
+ * make sure no other thread accesses the queue anymore. If ``queue`` is NULL,
+ * this is a no-op.
+ *
+ * Return: NULL is returned.
+ */
+static inline CMpmcQueue *c_mpmc_queue_free(CMpmcQueue *queue) {
+        free(queue);
+        return NULL;
+}
+
+/**
+ * c_mpmc_queue_push() - Enqueue element
+ * @queue:              Queue to operate on
+ * @item:               Element to enqueue
+ *
+ * Enqueue a single element. This can be called from any thread.
+ *
+ * Return: True if the element was enqueued, false if the queue is full.
+ */
+static inline bool c_mpmc_queue_push(CMpmcQueue *queue, void *item) {
+        CMpmcQueueCell *cell;
+        size_t head, sequence;
+        intptr_t diff;
+
+        head = c_atomic_load(&queue->head, C_ATOMIC_RELAXED);
+        for (;;) {
+                cell = &queue->cells[head & queue->mask];
+                sequence = c_atomic_load(&cell->sequence, C_ATOMIC_ACQUIRE);
+                diff = (intptr_t)(sequence - head);
+
+                if (diff == 0) {
+                        /* the cell is free, try to claim the position */
+                        if (c_atomic_cmpxchg_weak(&queue->head, &head, head + 1,
+                                                  C_ATOMIC_RELAXED, C_ATOMIC_RELAXED))
+                                break;
+                } else if (diff < 0) {
+                        /* the cell still holds an element from a lap ago */
+                        return false;
+                } else {
+                        /* another producer claimed the position, retry */
+                        head = c_atomic_load(&queue->head, C_ATOMIC_RELAXED);
+                }
+        }
+
+        cell->item = item;
+        c_atomic_store(&cell->sequence, head + 1, C_ATOMIC_RELEASE);
+        return true;
+}
+
+/**
+ * c_mpmc_queue_pop() - Dequeue element
+ * @queue:              Queue to operate on
+ * @itemp:              Output argument for the dequeued element
+ *
+ * Dequeue a single element. This can be called from any thread.
+ *
+ * Return: True if an element was dequeued, false if the queue is empty.
+ */
+static inline bool c_mpmc_queue_pop(CMpmcQueue *queue, void **itemp) {
+        CMpmcQueueCell *cell;
+        size_t tail, sequence;
+        intptr_t diff;
+
+        tail = c_atomic_load(&queue->tail, C_ATOMIC_RELAXED);
+        for (;;) {
+                cell = &queue->cells[tail & queue->mask];
+                sequence = c_atomic_load(&cell->sequence, C_ATOMIC_ACQUIRE);
+                diff = (intptr_t)(sequence - (tail + 1));
+
+                if (diff == 0) {
+                        /* the cell is written, try to claim the position */
+                        if (c_atomic_cmpxchg_weak(&queue->tail, &tail, tail + 1,
+                                                  C_ATOMIC_RELAXED, C_ATOMIC_RELAXED))
+                                break;
+                } else if (diff < 0) {
+                        /* the cell was not written in this lap, yet */
+                        return false;
+                } else {
+                        /* another consumer claimed the position, retry */
+                        tail = c_atomic_load(&queue->tail, C_ATOMIC_RELAXED);
+                }
+        }
+
+        *itemp = cell->item;
+        c_atomic_store(&cell->sequence, tail + queue->mask + 1, C_ATOMIC_RELEASE);
+        return true;
+}
+
+C_DEFINE_CLEANUP(CMpmcQueue *, c_mpmc_queue_free);
+
+#ifdef __cplusplus
+}
+#endif
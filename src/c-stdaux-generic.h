@@ -34,8 +34,10 @@ extern "C" {
  * - ``C_OS_LINUX``: The target system is compatible to Linux.
  * - ``C_OS_MACOS``: The target system is compatible to Apple MacOS.
  * - ``C_OS_WINDOWS``: The target system is compatible to Microsoft Windows.
+ * - ``C_MODULE_ATOMIC``: The `*-atomic.h` module was included.
  * - ``C_MODULE_GENERIC``: The `*-generic.h` module was included.
  * - ``C_MODULE_GNUC``: The `*-gnuc.h` module was included.
+ * - ``C_MODULE_HASH``: The `*-hash.h` module was included.
  * - ``C_MODULE_UNIX``: The `*-unix.h` module was included.
  *
  * Note that other exported symbols might depend on one of these constants to
@@ -72,6 +74,29 @@ extern "C" {
 #  define C_OS_WINDOWS 1
 #endif
 
+/**
+ * C_CACHELINE_SIZE - Size of a cache line
+ *
+ * This is the size in bytes of a cache line of the target architecture, or
+ * more precisely, the distance that objects written by different threads
+ * should keep to avoid false sharing. It is 128 on aarch64 and ppc64, 256 on
+ * s390x, and 64 everywhere else. Some architectures (e.g., aarch64) have
+ * implementations with 64-byte lines, but their prefetchers fetch pairs of
+ * lines, so the larger value is used.
+ *
+ * It can be overridden by defining it before including c-stdaux. Note that
+ * it affects the layout of structures, so all users must agree on it.
+ */
+#if !defined(C_CACHELINE_SIZE)
+#  if defined(__aarch64__) || defined(_M_ARM64) || defined(__powerpc64__)
+#    define C_CACHELINE_SIZE 128
+#  elif defined(__s390x__)
+#    define C_CACHELINE_SIZE 256
+#  else
+#    define C_CACHELINE_SIZE 64
+#  endif
+#endif
+
 /**
  * DOC: Guaranteed STD-C Includes
  *
@@ -173,6 +198,37 @@ extern "C" {
 #  define _c_internal_likely_(_x) (_c_boolean_expr_(_x))
 #endif
 
+/**
+ * c_prefetch_read() - Prefetch memory for reading
+ * @_ptr:               Address to prefetch
+ * @_locality:          Temporal locality, a constant between 0 and 3
+ *
+ * Hint the CPU to fetch the cache line containing ``_ptr``, since it will
+ * soon be read. ``_locality`` tells how long the data should stay in the
+ * caches: 0 means it is accessed only once, 3 means it should be kept in all
+ * cache levels. Prefetching never faults, so invalid addresses are fine.
+ *
+ * On GNUC targets this is an alias for ``__builtin_prefetch(_ptr, 0,
+ * _locality)``. On other systems, this is a no-op.
+ */
+#define c_prefetch_read(_ptr, _locality) c_internal_prefetch((_ptr), 0, (_locality))
+
+/**
+ * c_prefetch_write() - Prefetch memory for writing
+ * @_ptr:               Address to prefetch
+ * @_locality:          Temporal locality, a constant between 0 and 3
+ *
+ * This works like :c:macro:`c_prefetch_read()`, but hints the CPU that the
+ * cache line will soon be written, so it can be fetched in exclusive state.
+ */
+#define c_prefetch_write(_ptr, _locality) c_internal_prefetch((_ptr), 1, (_locality))
+
+#if defined(C_COMPILER_GNUC)
+#  define c_internal_prefetch(_ptr, _rw, _locality) __builtin_prefetch((_ptr), (_rw), (_locality))
+#else
+#  define c_internal_prefetch(_ptr, _rw, _locality) ((void)(_ptr))
+#endif
+
 /**
  * _c_public_() - Public attribute
  *
@@ -310,6 +366,50 @@ extern "C" {
 #  define c_internal_assume_aligned(_ptr, _alignment, _offset) ((void)(_alignment), (void)(_offset), (_ptr))
 #endif
 
+/**
+ * c_assume() - Hint condition to compiler
+ * @_x:                 Condition that is guaranteed to hold
+ *
+ * This tells the compiler that ``_x`` is true, so it can optimize based on
+ * it (e.g., drop range checks). If ``_x`` is false at runtime, the behavior
+ * is undefined. ``_x`` must not have side-effects, since it is unspecified
+ * whether it is evaluated.
+ *
+ * On clang this is an alias for ``__builtin_assume(_x)``, on other GNUC
+ * targets it uses ``__builtin_unreachable()``, and on MSVC targets it is an
+ * alias for ``__assume(_x)``. On other systems, this is a no-op.
+ */
+#define c_assume(_x) c_internal_assume(_x)
+#if defined(C_COMPILER_CLANG)
+#  define c_internal_assume(_x) __builtin_assume(_x)
+#elif defined(C_COMPILER_GNUC)
+#  define c_internal_assume(_x) ((_x) ? (void)0 : __builtin_unreachable())
+#elif defined(C_COMPILER_MSVC)
+#  define c_internal_assume(_x) __assume(_x)
+#else
+#  define c_internal_assume(_x) ((void)0)
+#endif
+
+/**
+ * c_unreachable() - Mark code as unreachable
+ *
+ * This tells the compiler that the current code path is never reached, so it
+ * can drop it, and can drop checks that lead to it. If it is reached at
+ * runtime, the behavior is undefined.
+ *
+ * On GNUC targets this is an alias for ``__builtin_unreachable()``, on MSVC
+ * targets it is an alias for ``__assume(0)``. On other systems, this calls
+ * ``abort()``.
+ */
+#define c_unreachable() c_internal_unreachable()
+#if defined(C_COMPILER_GNUC)
+#  define c_internal_unreachable() __builtin_unreachable()
+#elif defined(C_COMPILER_MSVC)
+#  define c_internal_unreachable() __assume(0)
+#else
+#  define c_internal_unreachable() abort()
+#endif
+
 /**
  * c_assert() - Runtime assertions
  * @_x:                 Result of an expression
@@ -322,11 +422,49 @@ extern "C" {
  * argument. This means side-effects will always be evaluated! However, if the
  * macro is used with constant expressions, the compiler will be able to
  * optimize it away.
+ *
+ * If ``C_ASSERT_ASSUME`` is defined to ``1`` (it defaults to ``0``), the
+ * asserted expression is additionally fed to the optimizer as an assumption,
+ * like :c:macro:`c_assume()`. With ``NDEBUG``, this turns a failed assertion
+ * into undefined behavior, but allows the compiler to rely on the asserted
+ * invariants (e.g., a length being a multiple of 8 lets loops be vectorized
+ * without a scalar remainder). Without ``NDEBUG``, this has no effect, since a
+ * failed assertion aborts anyway. Use :c:macro:`c_assert_always()` for checks
+ * that must never be compiled out.
  */
 #define c_assert(_x) (                                                          \
                 _c_likely_(_x)                                                  \
                         ? assert(true && #_x)                                   \
-                        : assert(false && #_x)                                  \
+                        : (assert(false && #_x), c_internal_assert_assume())    \
+        )
+
+#if !defined(C_ASSERT_ASSUME)
+#  define C_ASSERT_ASSUME 0
+#endif
+
+#define c_internal_assert_assume() (C_ASSERT_ASSUME ? c_unreachable() : (void)0)
+
+static inline noreturn void c_internal_assert_always(const char *expr,
+                                                     const char *file,
+                                                     int line,
+                                                     const char *func) {
+        fprintf(stderr, "%s:%d: %s: Assertion `%s' failed.\n", file, line, func, expr);
+        abort();
+}
+
+/**
+ * c_assert_always() - Runtime assertions that are never compiled out
+ * @_x:                 Result of an expression
+ *
+ * This works like :c:macro:`c_assert()`, but checks the expression regardless
+ * of ``NDEBUG`` and ``C_ASSERT_ASSUME``. If it is false, a message is printed
+ * to ``stderr`` and the program is aborted.
+ */
+#define c_assert_always(_x) (                                                   \
+                _c_likely_(_x)                                                  \
+                        ? (void)0                                               \
+                        : c_internal_assert_always(#_x, __FILE__,               \
+                                                   __LINE__, __func__)          \
         )
 
 /**
@@ -421,6 +559,150 @@ static inline int c_memcmp(const void *s1, const void *s2, size_t n) {
         return 0;
 }
 
+/**
+ * DOC: Checked Arithmetic
+ *
+ * Integer arithmetic in C silently wraps around (or is undefined for signed
+ * types) if the result cannot be represented. The helpers of this section
+ * report such overflows instead, which is needed, for instance, to safely
+ * calculate allocation sizes. On GNUC-compatible compilers, they map to the
+ * ``__builtin_*_overflow()`` family and thus compile to the arithmetic
+ * operation followed by a single flag check. Constant arguments are folded.
+ *
+ * A portable fallback is provided for all other compilers. It supports all
+ * standard integer types (and thus all their aliases) as result types, but
+ * requires both operands to be representable in the result type. The
+ * compiler builtins do not have this restriction.
+ */
+/**/
+
+/**
+ * c_add_overflow() - Add with overflow check
+ * @_a:         First operand
+ * @_b:         Second operand
+ * @_res:       Pointer to store the result at
+ *
+ * This calculates ``_a + _b`` and stores the result in ``*_res``. If the
+ * result cannot be represented in the type of ``*_res``, the value is wrapped
+ * around and true is returned.
+ *
+ * Return: True if the operation overflowed, false otherwise.
+ */
+#define c_add_overflow(_a, _b, _res) c_internal_add_overflow((_a), (_b), (_res))
+
+/**
+ * c_sub_overflow() - Subtract with overflow check
+ * @_a:         First operand
+ * @_b:         Second operand
+ * @_res:       Pointer to store the result at
+ *
+ * This calculates ``_a - _b`` and stores the result in ``*_res``. If the
+ * result cannot be represented in the type of ``*_res``, the value is wrapped
+ * around and true is returned.
+ *
+ * Return: True if the operation overflowed, false otherwise.
+ */
+#define c_sub_overflow(_a, _b, _res) c_internal_sub_overflow((_a), (_b), (_res))
+
+/**
+ * c_mul_overflow() - Multiply with overflow check
+ * @_a:         First operand
+ * @_b:         Second operand
+ * @_res:       Pointer to store the result at
+ *
+ * This calculates ``_a * _b`` and stores the result in ``*_res``. If the
+ * result cannot be represented in the type of ``*_res``, the value is wrapped
+ * around and true is returned.
+ *
+ * A typical use is calculating the size of an array allocation:
+ *
+ * .. code-block:: c
+ *
+ *     size_t size;
+ *
+ *     if (c_mul_overflow(n, sizeof(*array), &size))
+ *             return -ENOMEM;
+ *
+ *     array = malloc(size);
+ *
+ * Return: True if the operation overflowed, false otherwise.
+ */
+#define c_mul_overflow(_a, _b, _res) c_internal_mul_overflow((_a), (_b), (_res))
+
+#if defined(C_COMPILER_GNUC)
+#  define c_internal_add_overflow(_a, _b, _res) __builtin_add_overflow((_a), (_b), (_res))
+#  define c_internal_sub_overflow(_a, _b, _res) __builtin_sub_overflow((_a), (_b), (_res))
+#  define c_internal_mul_overflow(_a, _b, _res) __builtin_mul_overflow((_a), (_b), (_res))
+#else
+#  define C_INTERNAL_DEFINE_OVERFLOW_UNSIGNED(_name, _type, _max)               \
+        static inline bool                                                      \
+        c_internal_add_overflow_ ## _name(_type a, _type b, _type *res) {       \
+                *res = (_type)((unsigned long long)a + b);                      \
+                return a > (_max) - b;                                          \
+        }                                                                       \
+        static inline bool                                                      \
+        c_internal_sub_overflow_ ## _name(_type a, _type b, _type *res) {       \
+                *res = (_type)((unsigned long long)a - b);                      \
+                return a < b;                                                   \
+        }                                                                       \
+        static inline bool                                                      \
+        c_internal_mul_overflow_ ## _name(_type a, _type b, _type *res) {       \
+                *res = (_type)((unsigned long long)a * b);                      \
+                return b && a > (_max) / b;                                     \
+        }                                                                       \
+        struct c_internal_trailing_semicolon
+#  define C_INTERNAL_DEFINE_OVERFLOW_SIGNED(_name, _type, _min, _max)           \
+        static inline bool                                                      \
+        c_internal_add_overflow_ ## _name(_type a, _type b, _type *res) {       \
+                *res = (_type)((unsigned long long)a + (unsigned long long)b);  \
+                return b > 0 ? a > (_max) - b : a < (_min) - b;                 \
+        }                                                                       \
+        static inline bool                                                      \
+        c_internal_sub_overflow_ ## _name(_type a, _type b, _type *res) {       \
+                *res = (_type)((unsigned long long)a - (unsigned long long)b);  \
+                return b < 0 ? a > (_max) + b : a < (_min) + b;                 \
+        }                                                                       \
+        static inline bool                                                      \
+        c_internal_mul_overflow_ ## _name(_type a, _type b, _type *res) {       \
+                *res = (_type)((unsigned long long)a * (unsigned long long)b);  \
+                if (a > 0)                                                      \
+                        return b > 0 ? a > (_max) / b : b < (_min) / a;         \
+                else if (b > 0)                                                 \
+                        return a < (_min) / b;                                  \
+                else                                                            \
+                        return a != 0 && b < (_max) / a;                        \
+        }                                                                       \
+        struct c_internal_trailing_semicolon
+
+C_INTERNAL_DEFINE_OVERFLOW_SIGNED(schar, signed char, SCHAR_MIN, SCHAR_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_SIGNED(short, short, SHRT_MIN, SHRT_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_SIGNED(int, int, INT_MIN, INT_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_SIGNED(long, long, LONG_MIN, LONG_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_SIGNED(llong, long long, LLONG_MIN, LLONG_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_UNSIGNED(uchar, unsigned char, UCHAR_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_UNSIGNED(ushort, unsigned short, USHRT_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_UNSIGNED(uint, unsigned int, UINT_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_UNSIGNED(ulong, unsigned long, ULONG_MAX);
+C_INTERNAL_DEFINE_OVERFLOW_UNSIGNED(ullong, unsigned long long, ULLONG_MAX);
+
+#  define C_INTERNAL_OVERFLOW(_op, _a, _b, _res)                                \
+        _Generic(*(_res),                                                       \
+                signed char: c_internal_ ## _op ## _overflow_schar,             \
+                short: c_internal_ ## _op ## _overflow_short,                   \
+                int: c_internal_ ## _op ## _overflow_int,                       \
+                long: c_internal_ ## _op ## _overflow_long,                     \
+                long long: c_internal_ ## _op ## _overflow_llong,               \
+                unsigned char: c_internal_ ## _op ## _overflow_uchar,           \
+                unsigned short: c_internal_ ## _op ## _overflow_ushort,         \
+                unsigned int: c_internal_ ## _op ## _overflow_uint,             \
+                unsigned long: c_internal_ ## _op ## _overflow_ulong,           \
+                unsigned long long: c_internal_ ## _op ## _overflow_ullong      \
+        )((_a), (_b), (_res))
+#  define c_internal_add_overflow(_a, _b, _res) C_INTERNAL_OVERFLOW(add, _a, _b, _res)
+#  define c_internal_sub_overflow(_a, _b, _res) C_INTERNAL_OVERFLOW(sub, _a, _b, _res)
+#  define c_internal_mul_overflow(_a, _b, _res) C_INTERNAL_OVERFLOW(mul, _a, _b, _res)
+#endif
+
 /**
  * DOC: Memory Access
  *
@@ -440,6 +722,16 @@ static inline int c_memcmp(const void *s1, const void *s2, size_t n) {
  */
 /**/
 
+/*
+ * Byte order of the target, if it is known at compile-time. Helpers use this
+ * to select native fast-paths, and fall back to byte-wise access otherwise.
+ */
+#if defined(C_COMPILER_GNUC) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define C_INTERNAL_ENDIAN_LE 1
+#elif defined(C_COMPILER_GNUC) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#  define C_INTERNAL_ENDIAN_BE 1
+#endif
+
 /**
  * c_load_8() - Read a u8 from memory
  * @memory:     Memory location to operate on
@@ -650,6 +942,238 @@ static inline uint64_t c_load_64le_aligned(const void *memory, size_t offset) {
                ((uint64_t)m[6] << 48) | ((uint64_t)m[7] << 56);
 }
 
+/**
+ * c_load_24be_unaligned() - Read an unaligned big-endian u24 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned big-endian unsigned 24-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint32_t c_load_24be_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return ((uint32_t)c_load_16be_unaligned(m, 0) << 8) |
+               (uint32_t)c_load_16be_unaligned(m, 1);
+}
+
+/**
+ * c_load_24le_unaligned() - Read an unaligned little-endian u24 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned little-endian unsigned 24-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint32_t c_load_24le_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return (uint32_t)c_load_16le_unaligned(m, 0) |
+               ((uint32_t)c_load_16le_unaligned(m, 1) << 8);
+}
+
+/**
+ * c_load_40be_unaligned() - Read an unaligned big-endian u40 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned big-endian unsigned 40-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_load_40be_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return ((uint64_t)c_load_32be_unaligned(m, 0) << 8) |
+               (uint64_t)c_load_32be_unaligned(m, 1);
+}
+
+/**
+ * c_load_40le_unaligned() - Read an unaligned little-endian u40 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned little-endian unsigned 40-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_load_40le_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return (uint64_t)c_load_32le_unaligned(m, 0) |
+               ((uint64_t)c_load_32le_unaligned(m, 1) << 8);
+}
+
+/**
+ * c_load_48be_unaligned() - Read an unaligned big-endian u48 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned big-endian unsigned 48-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_load_48be_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return ((uint64_t)c_load_32be_unaligned(m, 0) << 16) |
+               (uint64_t)c_load_32be_unaligned(m, 2);
+}
+
+/**
+ * c_load_48le_unaligned() - Read an unaligned little-endian u48 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned little-endian unsigned 48-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_load_48le_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return (uint64_t)c_load_32le_unaligned(m, 0) |
+               ((uint64_t)c_load_32le_unaligned(m, 2) << 16);
+}
+
+/**
+ * c_load_56be_unaligned() - Read an unaligned big-endian u56 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned big-endian unsigned 56-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_load_56be_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return ((uint64_t)c_load_32be_unaligned(m, 0) << 24) |
+               (uint64_t)c_load_32be_unaligned(m, 3);
+}
+
+/**
+ * c_load_56le_unaligned() - Read an unaligned little-endian u56 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned little-endian unsigned 56-bit integer at the offset
+ * of the specified memory location. Odd-sized integers have no natural
+ * alignment, so no aligned variant is provided.
+ *
+ * The value is assembled from two overlapping power-of-two sized loads, which
+ * never touch memory outside of the integer.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_load_56le_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return (uint64_t)c_load_32le_unaligned(m, 0) |
+               ((uint64_t)c_load_32le_unaligned(m, 3) << 24);
+}
+
+#if defined(__SIZEOF_INT128__)
+
+/**
+ * c_load_128be_unaligned() - Read an unaligned big-endian u128 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned big-endian unsigned 128-bit integer at the offset
+ * of the specified memory location. This is only available if the target
+ * supports ``unsigned __int128``.
+ *
+ * Return: The read value is returned.
+ */
+static inline unsigned __int128 c_load_128be_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return ((unsigned __int128)c_load_64be_unaligned(m, 0) << 64) |
+               c_load_64be_unaligned(m, 8);
+}
+
+/**
+ * c_load_128be_aligned() - Read an aligned big-endian u128 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an aligned big-endian unsigned 128-bit integer at the offset
+ * of the specified memory location. This is only available if the target
+ * supports ``unsigned __int128``.
+ *
+ * Return: The read value is returned.
+ */
+static inline unsigned __int128 c_load_128be_aligned(const void *memory, size_t offset) {
+        const uint8_t *m = c_assume_aligned((const uint8_t *)memory + offset, 16, 0);
+        return ((unsigned __int128)c_load_64be_aligned(m, 0) << 64) |
+               c_load_64be_aligned(m, 8);
+}
+
+/**
+ * c_load_128le_unaligned() - Read an unaligned little-endian u128 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an unaligned little-endian unsigned 128-bit integer at the offset
+ * of the specified memory location. This is only available if the target
+ * supports ``unsigned __int128``.
+ *
+ * Return: The read value is returned.
+ */
+static inline unsigned __int128 c_load_128le_unaligned(const void *memory, size_t offset) {
+        const uint8_t *m = (const uint8_t *)memory + offset;
+        return ((unsigned __int128)c_load_64le_unaligned(m, 8) << 64) |
+               c_load_64le_unaligned(m, 0);
+}
+
+/**
+ * c_load_128le_aligned() - Read an aligned little-endian u128 from memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ *
+ * This reads an aligned little-endian unsigned 128-bit integer at the offset
+ * of the specified memory location. This is only available if the target
+ * supports ``unsigned __int128``.
+ *
+ * Return: The read value is returned.
+ */
+static inline unsigned __int128 c_load_128le_aligned(const void *memory, size_t offset) {
+        const uint8_t *m = c_assume_aligned((const uint8_t *)memory + offset, 16, 0);
+        return ((unsigned __int128)c_load_64le_aligned(m, 8) << 64) |
+               c_load_64le_aligned(m, 0);
+}
+
+#endif
+
 /**
  * c_load() - Read from memory
  * @_type:      Datatype to read
@@ -663,6 +1187,8 @@ static inline uint64_t c_load_64le_aligned(const void *memory, size_t offset) {
  * must be either `aligned` or `unaligned`.
  *
  * This is a generic macro that maps to the respective `c_load_*()` function.
+ * `_type` can be one of `uint16_t`, `uint32_t`, `uint64_t`, or
+ * `unsigned __int128` (if supported by the target).
  *
  * Return: The read value is returned.
  */
@@ -671,7 +1197,1599 @@ static inline uint64_t c_load_64le_aligned(const void *memory, size_t offset) {
                 uint16_t: c_load_16 ## _endian ## _ ## _aligned ((_memory), (_offset)), \
                 uint32_t: c_load_32 ## _endian ## _ ## _aligned ((_memory), (_offset)), \
                 uint64_t: c_load_64 ## _endian ## _ ## _aligned ((_memory), (_offset))  \
+                C_INTERNAL_LOAD_128(_endian, _aligned, _memory, _offset)                \
         ))
+#if defined(__SIZEOF_INT128__)
+#  define C_INTERNAL_LOAD_128(_endian, _aligned, _memory, _offset) \
+        , unsigned __int128: c_load_128 ## _endian ## _ ## _aligned ((_memory), (_offset))
+#else
+#  define C_INTERNAL_LOAD_128(_endian, _aligned, _memory, _offset)
+#endif
+
+/*
+ * The c_load_*_array() helpers either reduce to a plain ``memcpy()`` (if the
+ * byte order matches the target), or byte-swap each element. On x86 the
+ * latter uses SIMD kernels for the bulk of the array (SSE2 shifts and word
+ * shuffles, or ``pshufb`` if SSSE3 and AVX2 are enabled at compile-time). The
+ * remainder, as well as any other target, uses the scalar c_load_*() helpers,
+ * which compilers are free to auto-vectorize.
+ */
+#if defined(C_INTERNAL_ENDIAN_LE) && defined(__SSE2__)
+#  include <emmintrin.h>
+#  if defined(__SSSE3__)
+#    include <tmmintrin.h>
+#  endif
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#  endif
+#  define C_INTERNAL_LOAD_ARRAY_SIMD 1
+
+static inline __m128i c_internal_bswap_128(__m128i v, size_t width) {
+#  if defined(__SSSE3__)
+        const __m128i mask16 = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        const __m128i mask32 = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        const __m128i mask64 = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+        return _mm_shuffle_epi8(v, width == 2 ? mask16 : width == 4 ? mask32 : mask64);
+#  else
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        if (width == 4) {
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        } else if (width == 8) {
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+        return v;
+#  endif
+}
+
+static inline size_t c_internal_load_array_bswap(void *dst, const void *src, size_t n, size_t width) {
+        const uint8_t *s = (const uint8_t *)src;
+        uint8_t *d = (uint8_t *)dst;
+        size_t i = 0, size = n * width;
+
+#  if defined(__AVX2__)
+        {
+                const __m256i mask16 = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                                        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+                const __m256i mask32 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                                        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+                const __m256i mask64 = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+                const __m256i mask = width == 2 ? mask16 : width == 4 ? mask32 : mask64;
+                __m256i v;
+
+                for ( ; i + 32 <= size; i += 32) {
+                        v = _mm256_loadu_si256((const __m256i *)(s + i));
+                        _mm256_storeu_si256((__m256i *)(d + i), _mm256_shuffle_epi8(v, mask));
+                }
+        }
+#  endif
+
+        for ( ; i + 16 <= size; i += 16)
+                _mm_storeu_si128((__m128i *)(d + i),
+                                 c_internal_bswap_128(_mm_loadu_si128((const __m128i *)(s + i)), width));
+
+        return i / width;
+}
+#endif
+
+/**
+ * c_load_16be_array() - Read an array of big-endian u16 from memory
+ * @dst:        Target array
+ * @src:        Memory location to read from
+ * @n:          Number of elements to read
+ *
+ * This reads ``n`` consecutive unaligned big-endian unsigned 16-bit
+ * integers from ``src`` and stores them in native byte order in ``dst``. This
+ * has the same effect as calling :c:func:`c_load_16be_unaligned()` for each
+ * element, but is optimized for large arrays.
+ *
+ * ``dst`` and ``src`` may be equal to convert an array in-place, but must not
+ * overlap otherwise. If ``n`` is 0, either can be ``NULL``.
+ */
+static inline void c_load_16be_array(uint16_t *dst, const void *src, size_t n) {
+#if defined(C_INTERNAL_ENDIAN_BE)
+        if (dst != src)
+                c_memcpy(dst, src, n * sizeof(*dst));
+#else
+        size_t i = 0;
+
+#  if defined(C_INTERNAL_LOAD_ARRAY_SIMD)
+        i = c_internal_load_array_bswap(dst, src, n, sizeof(*dst));
+#  endif
+        for ( ; i < n; ++i)
+                dst[i] = c_load_16be_unaligned(src, i * sizeof(*dst));
+#endif
+}
+
+/**
+ * c_load_16le_array() - Read an array of little-endian u16 from memory
+ * @dst:        Target array
+ * @src:        Memory location to read from
+ * @n:          Number of elements to read
+ *
+ * This reads ``n`` consecutive unaligned little-endian unsigned 16-bit
+ * integers from ``src`` and stores them in native byte order in ``dst``. This
+ * has the same effect as calling :c:func:`c_load_16le_unaligned()` for each
+ * element, but is optimized for large arrays.
+ *
+ * ``dst`` and ``src`` may be equal to convert an array in-place, but must not
+ * overlap otherwise. If ``n`` is 0, either can be ``NULL``.
+ */
+static inline void c_load_16le_array(uint16_t *dst, const void *src, size_t n) {
+#if defined(C_INTERNAL_ENDIAN_LE)
+        if (dst != src)
+                c_memcpy(dst, src, n * sizeof(*dst));
+#else
+        size_t i = 0;
+
+#  if defined(C_INTERNAL_LOAD_ARRAY_SIMD)
+        i = c_internal_load_array_bswap(dst, src, n, sizeof(*dst));
+#  endif
+        for ( ; i < n; ++i)
+                dst[i] = c_load_16le_unaligned(src, i * sizeof(*dst));
+#endif
+}
+
+/**
+ * c_load_32be_array() - Read an array of big-endian u32 from memory
+ * @dst:        Target array
+ * @src:        Memory location to read from
+ * @n:          Number of elements to read
+ *
+ * This reads ``n`` consecutive unaligned big-endian unsigned 32-bit
+ * integers from ``src`` and stores them in native byte order in ``dst``. This
+ * has the same effect as calling :c:func:`c_load_32be_unaligned()` for each
+ * element, but is optimized for large arrays.
+ *
+ * ``dst`` and ``src`` may be equal to convert an array in-place, but must not
+ * overlap otherwise. If ``n`` is 0, either can be ``NULL``.
+ */
+static inline void c_load_32be_array(uint32_t *dst, const void *src, size_t n) {
+#if defined(C_INTERNAL_ENDIAN_BE)
+        if (dst != src)
+                c_memcpy(dst, src, n * sizeof(*dst));
+#else
+        size_t i = 0;
+
+#  if defined(C_INTERNAL_LOAD_ARRAY_SIMD)
+        i = c_internal_load_array_bswap(dst, src, n, sizeof(*dst));
+#  endif
+        for ( ; i < n; ++i)
+                dst[i] = c_load_32be_unaligned(src, i * sizeof(*dst));
+#endif
+}
+
+/**
+ * c_load_32le_array() - Read an array of little-endian u32 from memory
+ * @dst:        Target array
+ * @src:        Memory location to read from
+ * @n:          Number of elements to read
+ *
+ * This reads ``n`` consecutive unaligned little-endian unsigned 32-bit
+ * integers from ``src`` and stores them in native byte order in ``dst``. This
+ * has the same effect as calling :c:func:`c_load_32le_unaligned()` for each
+ * element, but is optimized for large arrays.
+ *
+ * ``dst`` and ``src`` may be equal to convert an array in-place, but must not
+ * overlap otherwise. If ``n`` is 0, either can be ``NULL``.
+ */
+static inline void c_load_32le_array(uint32_t *dst, const void *src, size_t n) {
+#if defined(C_INTERNAL_ENDIAN_LE)
+        if (dst != src)
+                c_memcpy(dst, src, n * sizeof(*dst));
+#else
+        size_t i = 0;
+
+#  if defined(C_INTERNAL_LOAD_ARRAY_SIMD)
+        i = c_internal_load_array_bswap(dst, src, n, sizeof(*dst));
+#  endif
+        for ( ; i < n; ++i)
+                dst[i] = c_load_32le_unaligned(src, i * sizeof(*dst));
+#endif
+}
+
+/**
+ * c_load_64be_array() - Read an array of big-endian u64 from memory
+ * @dst:        Target array
+ * @src:        Memory location to read from
+ * @n:          Number of elements to read
+ *
+ * This reads ``n`` consecutive unaligned big-endian unsigned 64-bit
+ * integers from ``src`` and stores them in native byte order in ``dst``. This
+ * has the same effect as calling :c:func:`c_load_64be_unaligned()` for each
+ * element, but is optimized for large arrays.
+ *
+ * ``dst`` and ``src`` may be equal to convert an array in-place, but must not
+ * overlap otherwise. If ``n`` is 0, either can be ``NULL``.
+ */
+static inline void c_load_64be_array(uint64_t *dst, const void *src, size_t n) {
+#if defined(C_INTERNAL_ENDIAN_BE)
+        if (dst != src)
+                c_memcpy(dst, src, n * sizeof(*dst));
+#else
+        size_t i = 0;
+
+#  if defined(C_INTERNAL_LOAD_ARRAY_SIMD)
+        i = c_internal_load_array_bswap(dst, src, n, sizeof(*dst));
+#  endif
+        for ( ; i < n; ++i)
+                dst[i] = c_load_64be_unaligned(src, i * sizeof(*dst));
+#endif
+}
+
+/**
+ * c_load_64le_array() - Read an array of little-endian u64 from memory
+ * @dst:        Target array
+ * @src:        Memory location to read from
+ * @n:          Number of elements to read
+ *
+ * This reads ``n`` consecutive unaligned little-endian unsigned 64-bit
+ * integers from ``src`` and stores them in native byte order in ``dst``. This
+ * has the same effect as calling :c:func:`c_load_64le_unaligned()` for each
+ * element, but is optimized for large arrays.
+ *
+ * ``dst`` and ``src`` may be equal to convert an array in-place, but must not
+ * overlap otherwise. If ``n`` is 0, either can be ``NULL``.
+ */
+static inline void c_load_64le_array(uint64_t *dst, const void *src, size_t n) {
+#if defined(C_INTERNAL_ENDIAN_LE)
+        if (dst != src)
+                c_memcpy(dst, src, n * sizeof(*dst));
+#else
+        size_t i = 0;
+
+#  if defined(C_INTERNAL_LOAD_ARRAY_SIMD)
+        i = c_internal_load_array_bswap(dst, src, n, sizeof(*dst));
+#  endif
+        for ( ; i < n; ++i)
+                dst[i] = c_load_64le_unaligned(src, i * sizeof(*dst));
+#endif
+}
+
+/*
+ * On GNUC targets with a known byte order, the c_store_*() helpers convert
+ * the value to the target byte order via ``__builtin_bswap*()`` (if needed)
+ * and then ``memcpy()`` the native integer to memory. This is reliably
+ * lowered to a single (possibly byte-swapping) move. All other targets fall
+ * back to byte-wise stores.
+ */
+#if defined(C_INTERNAL_ENDIAN_LE)
+#  define C_INTERNAL_STORE_NATIVE 1
+#  define c_internal_htobe16(_x) __builtin_bswap16(_x)
+#  define c_internal_htobe32(_x) __builtin_bswap32(_x)
+#  define c_internal_htobe64(_x) __builtin_bswap64(_x)
+#  define c_internal_htole16(_x) (_x)
+#  define c_internal_htole32(_x) (_x)
+#  define c_internal_htole64(_x) (_x)
+#elif defined(C_INTERNAL_ENDIAN_BE)
+#  define C_INTERNAL_STORE_NATIVE 1
+#  define c_internal_htobe16(_x) (_x)
+#  define c_internal_htobe32(_x) (_x)
+#  define c_internal_htobe64(_x) (_x)
+#  define c_internal_htole16(_x) __builtin_bswap16(_x)
+#  define c_internal_htole32(_x) __builtin_bswap32(_x)
+#  define c_internal_htole64(_x) __builtin_bswap64(_x)
+#endif
+
+/**
+ * c_store_8() - Write a u8 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an unsigned 8-bit integer at the offset of the specified memory
+ * location.
+ */
+static inline void c_store_8(void *memory, size_t offset, uint8_t value) {
+        ((uint8_t *)memory)[offset] = value;
+}
+
+/**
+ * c_store_16be_unaligned() - Write an unaligned big-endian u16 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an unaligned big-endian unsigned 16-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_16be_unaligned(void *memory, size_t offset, uint16_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htobe16(value);
+        memcpy((uint8_t *)memory + offset, &value, sizeof(value));
+#else
+        uint8_t *m = (uint8_t *)memory + offset;
+        m[0] = (uint8_t)(value >> 8);
+        m[1] = (uint8_t)(value >> 0);
+#endif
+}
+
+/**
+ * c_store_16be_aligned() - Write an aligned big-endian u16 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an aligned big-endian unsigned 16-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_16be_aligned(void *memory, size_t offset, uint16_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htobe16(value);
+        memcpy(c_assume_aligned((uint8_t *)memory + offset, 2, 0), &value, sizeof(value));
+#else
+        uint8_t *m = c_assume_aligned((uint8_t *)memory + offset, 2, 0);
+        m[0] = (uint8_t)(value >> 8);
+        m[1] = (uint8_t)(value >> 0);
+#endif
+}
+
+/**
+ * c_store_16le_unaligned() - Write an unaligned little-endian u16 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an unaligned little-endian unsigned 16-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_16le_unaligned(void *memory, size_t offset, uint16_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htole16(value);
+        memcpy((uint8_t *)memory + offset, &value, sizeof(value));
+#else
+        uint8_t *m = (uint8_t *)memory + offset;
+        m[0] = (uint8_t)(value >> 0);
+        m[1] = (uint8_t)(value >> 8);
+#endif
+}
+
+/**
+ * c_store_16le_aligned() - Write an aligned little-endian u16 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an aligned little-endian unsigned 16-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_16le_aligned(void *memory, size_t offset, uint16_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htole16(value);
+        memcpy(c_assume_aligned((uint8_t *)memory + offset, 2, 0), &value, sizeof(value));
+#else
+        uint8_t *m = c_assume_aligned((uint8_t *)memory + offset, 2, 0);
+        m[0] = (uint8_t)(value >> 0);
+        m[1] = (uint8_t)(value >> 8);
+#endif
+}
+
+/**
+ * c_store_32be_unaligned() - Write an unaligned big-endian u32 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an unaligned big-endian unsigned 32-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_32be_unaligned(void *memory, size_t offset, uint32_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htobe32(value);
+        memcpy((uint8_t *)memory + offset, &value, sizeof(value));
+#else
+        uint8_t *m = (uint8_t *)memory + offset;
+        m[0] = (uint8_t)(value >> 24);
+        m[1] = (uint8_t)(value >> 16);
+        m[2] = (uint8_t)(value >>  8);
+        m[3] = (uint8_t)(value >>  0);
+#endif
+}
+
+/**
+ * c_store_32be_aligned() - Write an aligned big-endian u32 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an aligned big-endian unsigned 32-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_32be_aligned(void *memory, size_t offset, uint32_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htobe32(value);
+        memcpy(c_assume_aligned((uint8_t *)memory + offset, 4, 0), &value, sizeof(value));
+#else
+        uint8_t *m = c_assume_aligned((uint8_t *)memory + offset, 4, 0);
+        m[0] = (uint8_t)(value >> 24);
+        m[1] = (uint8_t)(value >> 16);
+        m[2] = (uint8_t)(value >>  8);
+        m[3] = (uint8_t)(value >>  0);
+#endif
+}
+
+/**
+ * c_store_32le_unaligned() - Write an unaligned little-endian u32 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an unaligned little-endian unsigned 32-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_32le_unaligned(void *memory, size_t offset, uint32_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htole32(value);
+        memcpy((uint8_t *)memory + offset, &value, sizeof(value));
+#else
+        uint8_t *m = (uint8_t *)memory + offset;
+        m[0] = (uint8_t)(value >>  0);
+        m[1] = (uint8_t)(value >>  8);
+        m[2] = (uint8_t)(value >> 16);
+        m[3] = (uint8_t)(value >> 24);
+#endif
+}
+
+/**
+ * c_store_32le_aligned() - Write an aligned little-endian u32 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an aligned little-endian unsigned 32-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_32le_aligned(void *memory, size_t offset, uint32_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htole32(value);
+        memcpy(c_assume_aligned((uint8_t *)memory + offset, 4, 0), &value, sizeof(value));
+#else
+        uint8_t *m = c_assume_aligned((uint8_t *)memory + offset, 4, 0);
+        m[0] = (uint8_t)(value >>  0);
+        m[1] = (uint8_t)(value >>  8);
+        m[2] = (uint8_t)(value >> 16);
+        m[3] = (uint8_t)(value >> 24);
+#endif
+}
+
+/**
+ * c_store_64be_unaligned() - Write an unaligned big-endian u64 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an unaligned big-endian unsigned 64-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_64be_unaligned(void *memory, size_t offset, uint64_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htobe64(value);
+        memcpy((uint8_t *)memory + offset, &value, sizeof(value));
+#else
+        uint8_t *m = (uint8_t *)memory + offset;
+        m[0] = (uint8_t)(value >> 56);
+        m[1] = (uint8_t)(value >> 48);
+        m[2] = (uint8_t)(value >> 40);
+        m[3] = (uint8_t)(value >> 32);
+        m[4] = (uint8_t)(value >> 24);
+        m[5] = (uint8_t)(value >> 16);
+        m[6] = (uint8_t)(value >>  8);
+        m[7] = (uint8_t)(value >>  0);
+#endif
+}
+
+/**
+ * c_store_64be_aligned() - Write an aligned big-endian u64 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an aligned big-endian unsigned 64-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_64be_aligned(void *memory, size_t offset, uint64_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htobe64(value);
+        memcpy(c_assume_aligned((uint8_t *)memory + offset, 8, 0), &value, sizeof(value));
+#else
+        uint8_t *m = c_assume_aligned((uint8_t *)memory + offset, 8, 0);
+        m[0] = (uint8_t)(value >> 56);
+        m[1] = (uint8_t)(value >> 48);
+        m[2] = (uint8_t)(value >> 40);
+        m[3] = (uint8_t)(value >> 32);
+        m[4] = (uint8_t)(value >> 24);
+        m[5] = (uint8_t)(value >> 16);
+        m[6] = (uint8_t)(value >>  8);
+        m[7] = (uint8_t)(value >>  0);
+#endif
+}
+
+/**
+ * c_store_64le_unaligned() - Write an unaligned little-endian u64 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an unaligned little-endian unsigned 64-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_64le_unaligned(void *memory, size_t offset, uint64_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htole64(value);
+        memcpy((uint8_t *)memory + offset, &value, sizeof(value));
+#else
+        uint8_t *m = (uint8_t *)memory + offset;
+        m[0] = (uint8_t)(value >>  0);
+        m[1] = (uint8_t)(value >>  8);
+        m[2] = (uint8_t)(value >> 16);
+        m[3] = (uint8_t)(value >> 24);
+        m[4] = (uint8_t)(value >> 32);
+        m[5] = (uint8_t)(value >> 40);
+        m[6] = (uint8_t)(value >> 48);
+        m[7] = (uint8_t)(value >> 56);
+#endif
+}
+
+/**
+ * c_store_64le_aligned() - Write an aligned little-endian u64 to memory
+ * @memory:     Memory location to operate on
+ * @offset:     Offset in bytes from the pointed memory location
+ * @value:      Value to write
+ *
+ * This writes an aligned little-endian unsigned 64-bit integer at the offset
+ * of the specified memory location.
+ */
+static inline void c_store_64le_aligned(void *memory, size_t offset, uint64_t value) {
+#if defined(C_INTERNAL_STORE_NATIVE)
+        value = c_internal_htole64(value);
+        memcpy(c_assume_aligned((uint8_t *)memory + offset, 8, 0), &value, sizeof(value));
+#else
+        uint8_t *m = c_assume_aligned((uint8_t *)memory + offset, 8, 0);
+        m[0] = (uint8_t)(value >>  0);
+        m[1] = (uint8_t)(value >>  8);
+        m[2] = (uint8_t)(value >> 16);
+        m[3] = (uint8_t)(value >> 24);
+        m[4] = (uint8_t)(value >> 32);
+        m[5] = (uint8_t)(value >> 40);
+        m[6] = (uint8_t)(value >> 48);
+        m[7] = (uint8_t)(value >> 56);
+#endif
+}
+
+/**
+ * c_store() - Write to memory
+ * @_type:      Datatype to write
+ * @_endian:    Endianness
+ * @_aligned:   Aligned or unaligned access
+ * @_memory:    Memory location to operate on
+ * @_offset:    Offset in bytes from the pointed memory location
+ * @_value:     Value to write
+ *
+ * This writes `_value` as a value of the same size as `_type` at the offset
+ * of the specified memory location. `_endian` must be either `be` or `le`,
+ * `_aligned` must be either `aligned` or `unaligned`.
+ *
+ * This is a generic macro that maps to the respective `c_store_*()` function.
+ * It is the inverse of :c:macro:`c_load()`. Note that `_value` is explicitly
+ * converted to `_type`, so excess bits are silently discarded.
+ */
+#define c_store(_type, _endian, _aligned, _memory, _offset, _value)                                             \
+        (_Generic((_type){ 0 },                                                                                 \
+                uint16_t: c_store_16 ## _endian ## _ ## _aligned ((_memory), (_offset), (uint16_t)(_value)),    \
+                uint32_t: c_store_32 ## _endian ## _ ## _aligned ((_memory), (_offset), (uint32_t)(_value)),    \
+                uint64_t: c_store_64 ## _endian ## _ ## _aligned ((_memory), (_offset), (uint64_t)(_value))     \
+        ))
+
+/**
+ * DOC: Memory Cursors
+ *
+ * A cursor wraps a memory region and reads it sequentially, for instance to
+ * parse wire formats. Every read advances the cursor. The typed reads are
+ * based on the unaligned ``c_load_*()`` helpers, and slices are returned as
+ * pointers into the original memory region, rather than copies.
+ *
+ * Reads are unchecked. Instead, the caller is expected to verify the
+ * available length once via :c:func:`c_cursor_check()` before reading a group
+ * of fixed-size fields (e.g., a message header). Out-of-bounds reads are
+ * still caught via :c:macro:`c_assert()`, unless ``NDEBUG`` is defined.
+ *
+ * .. code-block:: c
+ *
+ *     CCursor c = C_CURSOR_INIT(data, n_data);
+ *
+ *     if (!c_cursor_check(&c, 8))
+ *             return -EBADMSG;
+ *
+ *     type = c_cursor_load(uint16_t, be, &c);
+ *     flags = c_cursor_load(uint16_t, be, &c);
+ *     length = c_cursor_load(uint32_t, be, &c);
+ *
+ *     if (!c_cursor_check(&c, length))
+ *             return -EBADMSG;
+ *
+ *     payload = c_cursor_pull(&c, length);
+ */
+/**/
+
+typedef struct CCursor CCursor;
+
+/**
+ * struct CCursor - Memory cursor
+ * @memory:     Start of the wrapped memory region
+ * @n_memory:   Size of the wrapped memory region in bytes
+ * @offset:     Current read position in bytes from @memory
+ */
+struct CCursor {
+        const void *memory;
+        size_t n_memory;
+        size_t offset;
+};
+
+/**
+ * C_CURSOR_INIT() - Initialize memory cursor
+ * @_memory:    Start of the memory region to wrap
+ * @_n_memory:  Size of the memory region in bytes
+ *
+ * Return: Evaluates to an initializer for a cursor positioned at the start of
+ *         the memory region.
+ */
+#define C_CURSOR_INIT(_memory, _n_memory) {                                     \
+                .memory = (_memory),                                            \
+                .n_memory = (_n_memory),                                        \
+                .offset = 0,                                                    \
+        }
+
+/**
+ * c_cursor_init() - Initialize memory cursor
+ * @cursor:     Cursor to initialize
+ * @memory:     Start of the memory region to wrap, if non-empty
+ * @n_memory:   Size of the memory region in bytes
+ *
+ * This is the function equivalent of :c:macro:`C_CURSOR_INIT()`.
+ */
+static inline void c_cursor_init(CCursor *cursor, const void *memory, size_t n_memory) {
+        cursor->memory = memory;
+        cursor->n_memory = n_memory;
+        cursor->offset = 0;
+}
+
+/**
+ * c_cursor_remaining() - Query remaining bytes of a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * Return: The number of bytes that can still be read is returned.
+ */
+static inline size_t c_cursor_remaining(const CCursor *cursor) {
+        return cursor->n_memory - cursor->offset;
+}
+
+/**
+ * c_cursor_check() - Check for remaining bytes of a cursor
+ * @cursor:     Cursor to operate on
+ * @n:          Number of bytes to check for
+ *
+ * Check whether at least ``n`` bytes can still be read from the cursor. Any
+ * sequence of reads with a combined length of at most ``n`` bytes is within
+ * bounds, if this returns ``true``.
+ *
+ * Return: True if at least ``n`` bytes remain, false otherwise.
+ */
+static inline bool c_cursor_check(const CCursor *cursor, size_t n) {
+        return n <= c_cursor_remaining(cursor);
+}
+
+/**
+ * c_cursor_pull() - Read a slice from a cursor
+ * @cursor:     Cursor to operate on
+ * @n:          Length of the slice in bytes
+ *
+ * Advance the cursor by ``n`` bytes and return a pointer to the skipped
+ * memory. No data is copied. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: Pointer to the start of the slice in the wrapped memory region.
+ */
+static inline const void *c_cursor_pull(CCursor *cursor, size_t n) {
+        const uint8_t *m = (const uint8_t *)cursor->memory + cursor->offset;
+
+        c_assert(c_cursor_check(cursor, n));
+        cursor->offset += n;
+        return m;
+}
+
+/**
+ * c_cursor_load_8() - Read a u8 from a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * This reads an unsigned 8-bit integer at the current position of the cursor
+ * and advances it. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint8_t c_cursor_load_8(CCursor *cursor) {
+        return c_load_8(c_cursor_pull(cursor, sizeof(uint8_t)), 0);
+}
+
+/**
+ * c_cursor_load_16be() - Read a big-endian u16 from a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * This reads a big-endian unsigned 16-bit integer at the current position
+ * of the cursor and advances it. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint16_t c_cursor_load_16be(CCursor *cursor) {
+        return c_load_16be_unaligned(c_cursor_pull(cursor, sizeof(uint16_t)), 0);
+}
+
+/**
+ * c_cursor_load_16le() - Read a little-endian u16 from a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * This reads a little-endian unsigned 16-bit integer at the current position
+ * of the cursor and advances it. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint16_t c_cursor_load_16le(CCursor *cursor) {
+        return c_load_16le_unaligned(c_cursor_pull(cursor, sizeof(uint16_t)), 0);
+}
+
+/**
+ * c_cursor_load_32be() - Read a big-endian u32 from a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * This reads a big-endian unsigned 32-bit integer at the current position
+ * of the cursor and advances it. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint32_t c_cursor_load_32be(CCursor *cursor) {
+        return c_load_32be_unaligned(c_cursor_pull(cursor, sizeof(uint32_t)), 0);
+}
+
+/**
+ * c_cursor_load_32le() - Read a little-endian u32 from a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * This reads a little-endian unsigned 32-bit integer at the current position
+ * of the cursor and advances it. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint32_t c_cursor_load_32le(CCursor *cursor) {
+        return c_load_32le_unaligned(c_cursor_pull(cursor, sizeof(uint32_t)), 0);
+}
+
+/**
+ * c_cursor_load_64be() - Read a big-endian u64 from a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * This reads a big-endian unsigned 64-bit integer at the current position
+ * of the cursor and advances it. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_cursor_load_64be(CCursor *cursor) {
+        return c_load_64be_unaligned(c_cursor_pull(cursor, sizeof(uint64_t)), 0);
+}
+
+/**
+ * c_cursor_load_64le() - Read a little-endian u64 from a cursor
+ * @cursor:     Cursor to operate on
+ *
+ * This reads a little-endian unsigned 64-bit integer at the current position
+ * of the cursor and advances it. The caller must have verified via
+ * :c:func:`c_cursor_check()` that enough data is available.
+ *
+ * Return: The read value is returned.
+ */
+static inline uint64_t c_cursor_load_64le(CCursor *cursor) {
+        return c_load_64le_unaligned(c_cursor_pull(cursor, sizeof(uint64_t)), 0);
+}
+
+/**
+ * c_cursor_load() - Read from a cursor
+ * @_type:      Datatype to read
+ * @_endian:    Endianness
+ * @_cursor:    Cursor to operate on
+ *
+ * This reads a value of the same size as `_type` at the current position of
+ * the cursor and advances it. `_endian` must be either `be` or `le`.
+ *
+ * This is a generic macro that maps to the respective `c_cursor_load_*()`
+ * function.
+ *
+ * Return: The read value is returned.
+ */
+#define c_cursor_load(_type, _endian, _cursor)                                  \
+        (_Generic((_type){ 0 },                                                 \
+                uint16_t: c_cursor_load_16 ## _endian ((_cursor)),              \
+                uint32_t: c_cursor_load_32 ## _endian ((_cursor)),              \
+                uint64_t: c_cursor_load_64 ## _endian ((_cursor))               \
+        ))
+
+/**
+ * DOC: Variable-Length Integers
+ *
+ * Helpers to encode and decode unsigned LEB128 integers (also known as
+ * varints), as used by many wire formats. Each byte carries 7 bits of the
+ * value, least-significant group first, and the most-significant bit of each
+ * byte signals that another byte follows. Signed integers are mapped to
+ * unsigned integers via zigzag-encoding first, so small negative values yield
+ * short encodings as well.
+ *
+ * Encodings are limited to :c:macro:`C_VARINT_MAX` bytes, which is sufficient
+ * for any 64-bit value. Non-canonical encodings (i.e., with trailing zero
+ * groups) are accepted by the decoders.
+ */
+/**/
+
+/**
+ * C_VARINT_MAX - Maximum length of an encoded varint
+ *
+ * This is the maximum number of bytes needed to encode a 64-bit value as
+ * varint.
+ */
+#define C_VARINT_MAX 10
+
+static inline size_t c_internal_varint_decode_slow(const uint8_t *m, size_t n_memory, uint64_t *valuep) {
+        uint64_t v = 0;
+        size_t i;
+
+        if (n_memory > C_VARINT_MAX)
+                n_memory = C_VARINT_MAX;
+
+        for (i = 0; i < n_memory; ++i) {
+                v |= (uint64_t)(m[i] & 0x7f) << (7 * i);
+                if (!(m[i] & 0x80)) {
+                        /* the last group only has space for a single bit */
+                        if (i == C_VARINT_MAX - 1 && m[i] > 1)
+                                return 0;
+
+                        *valuep = v;
+                        return i + 1;
+                }
+        }
+
+        return 0;
+}
+
+static inline size_t c_internal_varint_decode_word(const uint8_t *m, size_t n_memory, uint64_t *valuep) {
+        uint64_t w, stop, tail;
+        size_t n;
+
+        /*
+         * Load 8 bytes at once and find the first byte without continuation
+         * bit. Then mask off all following bytes, and compact the 7-bit
+         * groups in log2(8) steps. Only values longer than 8 bytes fall back
+         * to the byte-wise decoder for their tail.
+         */
+
+        w = c_load_64le_unaligned(m, 0);
+        stop = ~w & UINT64_C(0x8080808080808080);
+        if (_c_likely_(stop))
+                w &= stop ^ (stop - 1);
+
+        w &= UINT64_C(0x7f7f7f7f7f7f7f7f);
+        w = (w & UINT64_C(0x007f007f007f007f)) | ((w & UINT64_C(0x7f007f007f007f00)) >> 1);
+        w = (w & UINT64_C(0x00003fff00003fff)) | ((w & UINT64_C(0x3fff00003fff0000)) >> 2);
+        w = (w & UINT64_C(0x000000000fffffff)) | ((w & UINT64_C(0x0fffffff00000000)) >> 4);
+
+        if (_c_likely_(stop)) {
+#if defined(C_COMPILER_GNUC)
+                n = __builtin_ctzll(stop) / 8 + 1;
+#else
+                for (n = 1; !(stop & 0x80); ++n)
+                        stop >>= 8;
+#endif
+                *valuep = w;
+                return n;
+        }
+
+        /* at most 2 more groups with 8 bits in total can follow */
+        n = c_internal_varint_decode_slow(m + 8, n_memory - 8, &tail);
+        if (!n || n > 2 || tail > 0xff)
+                return 0;
+
+        *valuep = w | (tail << 56);
+        return 8 + n;
+}
+
+/**
+ * c_varint_decode_u64() - Decode an unsigned varint
+ * @memory:     Memory location to decode from
+ * @n_memory:   Number of bytes available at ``memory``
+ * @valuep:     Output argument for the decoded value
+ *
+ * This decodes an unsigned varint from the start of the memory region. Values
+ * of one or two bytes are decoded via a dedicated fast-path. Longer values
+ * are decoded a word at a time, if the memory region is large enough.
+ *
+ * If the memory region is empty, ``memory`` can be ``NULL``. ``valuep`` is
+ * left untouched on failure.
+ *
+ * Return: The length of the encoded value in bytes is returned, or 0 if the
+ *         memory region does not contain a complete varint or the value
+ *         overflows 64 bits.
+ */
+static inline size_t c_varint_decode_u64(const void *memory, size_t n_memory, uint64_t *valuep) {
+        const uint8_t *m = (const uint8_t *)memory;
+
+        if (_c_likely_(n_memory >= 2)) {
+                if (!(m[0] & 0x80)) {
+                        *valuep = m[0];
+                        return 1;
+                }
+                if (!(m[1] & 0x80)) {
+                        *valuep = (uint64_t)(m[0] & 0x7f) | ((uint64_t)m[1] << 7);
+                        return 2;
+                }
+                if (n_memory >= 8)
+                        return c_internal_varint_decode_word(m, n_memory, valuep);
+        }
+
+        return c_internal_varint_decode_slow(m, n_memory, valuep);
+}
+
+/**
+ * c_varint_encode_u64() - Encode an unsigned varint
+ * @memory:     Memory location to encode to
+ * @value:      Value to encode
+ *
+ * This encodes ``value`` as unsigned varint at the start of the memory
+ * region, which must be large enough to hold :c:macro:`C_VARINT_MAX` bytes.
+ *
+ * Return: The length of the encoded value in bytes is returned.
+ */
+static inline size_t c_varint_encode_u64(void *memory, uint64_t value) {
+        uint8_t *m = (uint8_t *)memory;
+        size_t n = 0;
+
+        while (value >= 0x80) {
+                m[n++] = (uint8_t)value | 0x80;
+                value >>= 7;
+        }
+
+        m[n++] = (uint8_t)value;
+        return n;
+}
+
+/**
+ * c_varint_decode_s64() - Decode a signed zigzag varint
+ * @memory:     Memory location to decode from
+ * @n_memory:   Number of bytes available at ``memory``
+ * @valuep:     Output argument for the decoded value
+ *
+ * This works like :c:func:`c_varint_decode_u64()` but reverts the zigzag
+ * mapping of :c:func:`c_varint_encode_s64()` on the decoded value.
+ *
+ * Return: The length of the encoded value in bytes is returned, or 0 on
+ *         failure.
+ */
+static inline size_t c_varint_decode_s64(const void *memory, size_t n_memory, int64_t *valuep) {
+        uint64_t v;
+        size_t n;
+
+        n = c_varint_decode_u64(memory, n_memory, &v);
+        if (n)
+                *valuep = (int64_t)((v >> 1) ^ (0 - (v & 1)));
+        return n;
+}
+
+/**
+ * c_varint_encode_s64() - Encode a signed zigzag varint
+ * @memory:     Memory location to encode to
+ * @value:      Value to encode
+ *
+ * This maps ``value`` to an unsigned integer via zigzag-encoding (i.e., 0, -1,
+ * 1, -2, 2, ... map to 0, 1, 2, 3, 4, ...) and then encodes it via
+ * :c:func:`c_varint_encode_u64()`.
+ *
+ * Return: The length of the encoded value in bytes is returned.
+ */
+static inline size_t c_varint_encode_s64(void *memory, int64_t value) {
+        return c_varint_encode_u64(memory, ((uint64_t)value << 1) ^ (0 - ((uint64_t)value >> 63)));
+}
+
+/**
+ * c_cursor_load_varint() - Read an unsigned varint from a cursor
+ * @cursor:     Cursor to operate on
+ * @valuep:     Output argument for the decoded value
+ *
+ * This decodes an unsigned varint at the current position of the cursor and
+ * advances it. Unlike the fixed-size reads on a cursor, this checks the
+ * bounds of the cursor, since the length of a varint is not known upfront.
+ *
+ * Return: True on success, false if no valid varint is available.
+ */
+static inline bool c_cursor_load_varint(CCursor *cursor, uint64_t *valuep) {
+        size_t n;
+
+        n = c_varint_decode_u64((const uint8_t *)cursor->memory + cursor->offset,
+                                c_cursor_remaining(cursor),
+                                valuep);
+        cursor->offset += n;
+        return n;
+}
+
+/**
+ * DOC: Vectors
+ *
+ * A vector is a growable array of elements of a single type. Since C lacks
+ * generics, vectors are instantiated for a specific element type via
+ * :c:macro:`C_DEFINE_VECTOR()`, which defines the vector type and a set of
+ * static inline functions operating on it:
+ *
+ * .. code-block:: c
+ *
+ *     C_DEFINE_VECTOR(IntVector, int);
+ *
+ *     _c_cleanup_(IntVector_deinitp) IntVector v = { 0 };
+ *     int r;
+ *
+ *     r = IntVector_push(&v, 71);
+ *     if (r)
+ *             return r;
+ *
+ * A zero-initialized vector is valid and empty. Elements are stored
+ * contiguously in ``data``, and ``n`` is the number of elements. Both can be
+ * accessed directly by the caller. The capacity grows geometrically, so
+ * appending elements takes amortized constant time. All size calculations are
+ * checked for overflows.
+ *
+ * Note that elements are moved in memory when the vector grows, or elements
+ * are inserted. Pointers to elements are thus invalidated by any operation
+ * that adds elements.
+ */
+/**/
+
+/* minimum capacity of a grown vector, to avoid reallocations for tiny vectors */
+#define C_INTERNAL_VECTOR_MIN_BYTES ((size_t)64)
+
+static inline void *c_internal_vector_resize(void *data,
+                                             size_t *capacityp,
+                                             size_t capacity,
+                                             size_t size) {
+        size_t n;
+
+        if (c_mul_overflow(capacity, size, &n))
+                return NULL;
+
+        data = realloc(data, n);
+        if (!data)
+                return NULL;
+
+        *capacityp = capacity;
+        return data;
+}
+
+static inline void *c_internal_vector_grow(void *data,
+                                           size_t *capacityp,
+                                           size_t required,
+                                           size_t size) {
+        size_t capacity;
+
+        if (c_add_overflow(*capacityp, *capacityp, &capacity))
+                capacity = SIZE_MAX;
+        if (capacity < C_INTERNAL_VECTOR_MIN_BYTES / size)
+                capacity = C_INTERNAL_VECTOR_MIN_BYTES / size;
+        if (capacity < required)
+                capacity = required;
+
+        return c_internal_vector_resize(data, capacityp, capacity, size);
+}
+
+/**
+ * C_DEFINE_VECTOR() - Define vector type
+ * @_name:      Name of the vector type, and prefix of its functions
+ * @_type:      Element type
+ *
+ * Define a vector type called ``_name`` with elements of type ``_type``, and
+ * a set of static inline functions to operate on it. The type is defined as:
+ *
+ * .. code-block:: c
+ *
+ *     typedef struct _name {
+ *             _type *data;
+ *             size_t n;
+ *             size_t capacity;
+ *     } _name;
+ *
+ * The following functions are defined, prefixed with ``_name`` (e.g.,
+ * ``_name_push()``):
+ *
+ * - ``int _reserve(_name *v, size_t capacity)``: Ensure the capacity is at
+ *   least ``capacity`` elements.
+ * - ``int _push(_name *v, _type value)``: Append ``value``.
+ * - ``int _insert(_name *v, size_t index, _type value)``: Insert ``value`` at
+ *   ``index``, moving all following elements back by one. ``index`` must not
+ *   exceed ``n``.
+ * - ``_type _pop(_name *v)``: Remove and return the last element. The vector
+ *   must not be empty.
+ * - ``int _shrink(_name *v)``: Reduce the capacity to the number of elements.
+ * - ``void _deinit(_name *v)``: Release all memory, leaving an empty vector.
+ * - ``void _deinitp(_name *v)``: Cleanup helper for ``_c_cleanup_()``.
+ *
+ * All functions returning ``int`` return 0 on success, or ``-ENOMEM`` if out
+ * of memory (or if the requested size cannot be represented). On failure,
+ * the vector is left unmodified.
+ */
+#define C_DEFINE_VECTOR(_name, _type)                                                   \
+        typedef struct _name {                                                          \
+                _type *data;                                                            \
+                size_t n;                                                               \
+                size_t capacity;                                                        \
+        } _name;                                                                        \
+                                                                                        \
+        static inline int _name ## _reserve(_name *v, size_t capacity) {                \
+                _type *data;                                                            \
+                                                                                        \
+                if (capacity > v->capacity) {                                           \
+                        data = c_internal_vector_resize(v->data, &v->capacity,          \
+                                                        capacity, sizeof(_type));       \
+                        if (!data)                                                      \
+                                return -ENOMEM;                                         \
+                        v->data = data;                                                 \
+                }                                                                       \
+                                                                                        \
+                return 0;                                                               \
+        }                                                                               \
+                                                                                        \
+        static inline int _name ## _push(_name *v, _type value) {                       \
+                _type *data;                                                            \
+                                                                                        \
+                if (_c_unlikely_(v->n >= v->capacity)) {                                \
+                        data = c_internal_vector_grow(v->data, &v->capacity,            \
+                                                      v->n + 1, sizeof(_type));         \
+                        if (!data)                                                      \
+                                return -ENOMEM;                                         \
+                        v->data = data;                                                 \
+                }                                                                       \
+                                                                                        \
+                v->data[v->n++] = value;                                                \
+                return 0;                                                               \
+        }                                                                               \
+                                                                                        \
+        static inline int _name ## _insert(_name *v, size_t index, _type value) {      \
+                _type *data;                                                            \
+                                                                                        \
+                c_assert(index <= v->n);                                                \
+                                                                                        \
+                if (_c_unlikely_(v->n >= v->capacity)) {                                \
+                        data = c_internal_vector_grow(v->data, &v->capacity,            \
+                                                      v->n + 1, sizeof(_type));         \
+                        if (!data)                                                      \
+                                return -ENOMEM;                                         \
+                        v->data = data;                                                 \
+                }                                                                       \
+                                                                                        \
+                memmove(v->data + index + 1, v->data + index,                           \
+                        (v->n - index) * sizeof(_type));                                \
+                v->data[index] = value;                                                 \
+                ++v->n;                                                                 \
+                return 0;                                                               \
+        }                                                                               \
+                                                                                        \
+        static inline _type _name ## _pop(_name *v) {                                   \
+                c_assert(v->n > 0);                                                     \
+                return v->data[--v->n];                                                 \
+        }                                                                               \
+                                                                                        \
+        static inline int _name ## _shrink(_name *v) {                                  \
+                _type *data;                                                            \
+                                                                                        \
+                if (!v->n) {                                                            \
+                        v->data = c_free(v->data);                                      \
+                        v->capacity = 0;                                                \
+                } else if (v->n < v->capacity) {                                        \
+                        data = c_internal_vector_resize(v->data, &v->capacity,          \
+                                                        v->n, sizeof(_type));           \
+                        if (!data)                                                      \
+                                return -ENOMEM;                                         \
+                        v->data = data;                                                 \
+                }                                                                       \
+                                                                                        \
+                return 0;                                                               \
+        }                                                                               \
+                                                                                        \
+        static inline void _name ## _deinit(_name *v) {                                 \
+                v->data = c_free(v->data);                                              \
+                v->n = 0;                                                               \
+                v->capacity = 0;                                                        \
+        }                                                                               \
+                                                                                        \
+        static inline void _name ## _deinitp(_name *v) {                                \
+                _name ## _deinit(v);                                                    \
+        }                                                                               \
+                                                                                        \
+        struct c_internal_trailing_semicolon
+
+/**
+ * DOC: Hash Maps
+ *
+ * A hash map associates values with unique keys. Hash maps are instantiated
+ * for specific key and value types via :c:macro:`C_DEFINE_HASHMAP()`, which
+ * defines the hash map type and a set of static inline functions operating on
+ * it:
+ *
+ * .. code-block:: c
+ *
+ *     static uint64_t foo_hash(const uint64_t *key) { ... }
+ *     static bool foo_equal(const uint64_t *a, const uint64_t *b) { return *a == *b; }
+ *
+ *     C_DEFINE_HASHMAP(FooMap, uint64_t, Foo *, foo_hash, foo_equal);
+ *
+ *     _c_cleanup_(FooMap_deinitp) FooMap map = { 0 };
+ *     Foo **foop;
+ *     int r;
+ *
+ *     r = FooMap_insert(&map, 71, foo);
+ *     if (r)
+ *             return r;
+ *
+ *     foop = FooMap_find(&map, &(uint64_t){ 71 });
+ *
+ * A zero-initialized hash map is valid and empty. The map uses open
+ * addressing with linear probing over a flat array of entries, so a lookup
+ * usually touches one line of control bytes and one line of entries, rather
+ * than chasing a pointer per chained entry. Every entry has a control byte, which stores 7 bits of the hash of
+ * its key, or marks the entry as empty. Lookups compare the control bytes of
+ * 16 consecutive entries at once (via SSE2 if available, otherwise via 64-bit
+ * bit manipulation), and only compare keys of entries whose control byte
+ * matches. Deletion shifts following entries back, rather than leaving
+ * tombstones, so lookups never degrade with churn.
+ *
+ * The capacity is always a power of 2 and the map is kept at most 7/8 full.
+ * The lower bits of the hash select the initial position, and its 7 upper
+ * bits are stored in the control byte. Hence, the hash function must mix all
+ * input bits into both.
+ *
+ * Entries are moved in memory when the map grows, or entries are removed.
+ * Pointers to keys or values are thus invalidated by any modification.
+ *
+ * In ``bench-hashmap``, with 1k to 1M entries, lookups of random keys are
+ * faster than in a chained hash table, for both present and absent keys. A
+ * short sequence of keys that is looked up over and over is an exception. The
+ * branch predictor then learns the chains of the chained table, which is
+ * faster for present keys in tables of up to 64k entries.
+ */
+/**/
+
+#define C_INTERNAL_HASHMAP_GROUP 16
+#define C_INTERNAL_HASHMAP_EMPTY ((uint8_t)0x80)
+
+static inline unsigned int c_internal_hashmap_ctz(unsigned int mask) {
+#if defined(C_COMPILER_GNUC)
+        return (unsigned int)__builtin_ctz(mask);
+#else
+        unsigned int n;
+
+        for (n = 0; !(mask & 1); ++n)
+                mask >>= 1;
+
+        return n;
+#endif
+}
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+/* bitmask of the 16 control bytes at @ctrl that equal @h2 */
+static inline unsigned int c_internal_hashmap_match(const uint8_t *ctrl, uint8_t h2) {
+        __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+        return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+}
+
+/* bitmask of the 16 control bytes at @ctrl that mark empty entries */
+static inline unsigned int c_internal_hashmap_match_empty(const uint8_t *ctrl) {
+        return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+#else
+
+/* gather the high bit of each byte of @w into an 8-bit mask */
+static inline unsigned int c_internal_hashmap_mask(uint64_t w) {
+        return (unsigned int)((((w & UINT64_C(0x8080808080808080)) >> 7) *
+                               UINT64_C(0x0102040810204080)) >> 56);
+}
+
+static inline unsigned int c_internal_hashmap_match_8(uint64_t w, uint8_t h2) {
+        uint64_t x = w ^ (UINT64_C(0x0101010101010101) * h2);
+
+        /* exact zero-byte detection, without carries across bytes */
+        x = ~(((x & UINT64_C(0x7f7f7f7f7f7f7f7f)) + UINT64_C(0x7f7f7f7f7f7f7f7f)) |
+              x | UINT64_C(0x7f7f7f7f7f7f7f7f));
+        return c_internal_hashmap_mask(x);
+}
+
+static inline unsigned int c_internal_hashmap_match(const uint8_t *ctrl, uint8_t h2) {
+        return c_internal_hashmap_match_8(c_load_64le_unaligned(ctrl, 0), h2) |
+               c_internal_hashmap_match_8(c_load_64le_unaligned(ctrl, 8), h2) << 8;
+}
+
+static inline unsigned int c_internal_hashmap_match_empty(const uint8_t *ctrl) {
+        return c_internal_hashmap_mask(c_load_64le_unaligned(ctrl, 0)) |
+               c_internal_hashmap_mask(c_load_64le_unaligned(ctrl, 8)) << 8;
+}
+
+#endif
+
+static inline uint8_t c_internal_hashmap_h2(uint64_t hash) {
+        return (uint8_t)(hash >> 57);
+}
+
+/*
+ * The first group of control bytes is mirrored behind the last entry, so
+ * groups can be loaded at any position without wrapping around.
+ */
+static inline void c_internal_hashmap_set_ctrl(uint8_t *ctrl, size_t mask, size_t i, uint8_t v) {
+        ctrl[i] = v;
+        if (i < C_INTERNAL_HASHMAP_GROUP)
+                ctrl[mask + 1 + i] = v;
+}
+
+static inline size_t c_internal_hashmap_find_empty(const uint8_t *ctrl, size_t mask, uint64_t hash) {
+        size_t pos = hash & mask;
+        unsigned int empty;
+
+        for (;;) {
+                empty = c_internal_hashmap_match_empty(ctrl + pos);
+                if (empty)
+                        return (pos + c_internal_hashmap_ctz(empty)) & mask;
+
+                pos = (pos + C_INTERNAL_HASHMAP_GROUP) & mask;
+        }
+}
+
+/*
+ * Allocate the backing memory of a hash map with @capacity entries of @size
+ * bytes each, followed by the control bytes (all marked empty).
+ */
+static inline void *c_internal_hashmap_alloc(size_t capacity, size_t size, uint8_t **ctrlp) {
+        size_t n, n_ctrl = capacity + C_INTERNAL_HASHMAP_GROUP;
+        uint8_t *p;
+
+        if (c_mul_overflow(capacity, size, &n) ||
+            c_add_overflow(n, n_ctrl, &n))
+                return NULL;
+
+        p = malloc(n);
+        if (!p)
+                return NULL;
+
+        *ctrlp = p + capacity * size;
+        memset(*ctrlp, C_INTERNAL_HASHMAP_EMPTY, n_ctrl);
+        return p;
+}
+
+/**
+ * C_DEFINE_HASHMAP() - Define hash map type
+ * @_name:      Name of the hash map type, and prefix of its functions
+ * @_key:       Key type
+ * @_value:     Value type
+ * @_hash:      Hash function, ``uint64_t _hash(const _key *key)``
+ * @_equal:     Equality function, ``bool _equal(const _key *a, const _key *b)``
+ *
+ * Define a hash map type called ``_name`` mapping keys of type ``_key`` to
+ * values of type ``_value``, and a set of static inline functions to operate
+ * on it. The types are defined as:
+ *
+ * .. code-block:: c
+ *
+ *     typedef struct _nameEntry {
+ *             _key key;
+ *             _value value;
+ *     } _nameEntry;
+ *
+ *     typedef struct _name {
+ *             _nameEntry *entries;
+ *             uint8_t *ctrl;
+ *             size_t n;
+ *             size_t mask;
+ *     } _name;
+ *
+ * Only ``n``, the number of entries, is meant to be accessed by the caller.
+ * The following functions are defined, prefixed with ``_name`` (e.g.,
+ * ``_name_insert()``):
+ *
+ * - ``int _reserve(_name *m, size_t n)``: Ensure ``n`` entries fit without
+ *   growing the map.
+ * - ``int _insert(_name *m, _key key, _value value)``: Insert a new entry.
+ *   Returns ``-EEXIST`` if the key is already present, leaving the map
+ *   unmodified.
+ * - ``_value *_find(_name *m, const _key *key)``: Look up the value of
+ *   ``key``, or NULL if not present.
+ * - ``bool _remove(_name *m, const _key *key, _value *valuep)``: Remove the
+ *   entry of ``key``, storing its value in ``valuep`` unless NULL. Returns
+ *   false if the key was not present.
+ * - ``_nameEntry *_next(_name *m, size_t *iter)``: Iterate all entries, in no
+ *   particular order. ``*iter`` must be initialized to 0. Returns NULL at the
+ *   end. Keys of returned entries must not be modified.
+ * - ``void _deinit(_name *m)``: Release all memory, leaving an empty map.
+ * - ``void _deinitp(_name *m)``: Cleanup helper for ``_c_cleanup_()``.
+ *
+ * All functions returning ``int`` return 0 on success, or ``-ENOMEM`` if out
+ * of memory (or if the requested size cannot be represented). On failure,
+ * the map is left unmodified.
+ */
+#define C_DEFINE_HASHMAP(_name, _key, _value, _hash, _equal)                                    \
+        typedef struct _name ## Entry {                                                         \
+                _key key;                                                                       \
+                _value value;                                                                   \
+        } _name ## Entry;                                                                       \
+                                                                                                \
+        typedef struct _name {                                                                  \
+                _name ## Entry *entries;                                                        \
+                uint8_t *ctrl;                                                                  \
+                size_t n;                                                                       \
+                size_t mask;                                                                    \
+        } _name;                                                                                \
+                                                                                                \
+        static inline int _name ## _reserve(_name *m, size_t n) {                               \
+                _name ## Entry *entries;                                                        \
+                size_t i, j, capacity = C_INTERNAL_HASHMAP_GROUP;                               \
+                uint8_t *ctrl;                                                                  \
+                uint64_t hash;                                                                  \
+                                                                                                \
+                while (capacity - capacity / 8 < n) {                                           \
+                        if (capacity > SIZE_MAX / 2)                                            \
+                                return -ENOMEM;                                                 \
+                        capacity *= 2;                                                          \
+                }                                                                               \
+                if (m->ctrl && capacity <= m->mask + 1)                                         \
+                        return 0;                                                               \
+                                                                                                \
+                entries = c_internal_hashmap_alloc(capacity, sizeof(*entries), &ctrl);          \
+                if (!entries)                                                                   \
+                        return -ENOMEM;                                                         \
+                                                                                                \
+                for (i = 0; m->ctrl && i <= m->mask; ++i) {                                     \
+                        if (m->ctrl[i] & C_INTERNAL_HASHMAP_EMPTY)                              \
+                                continue;                                                       \
+                                                                                                \
+                        hash = _hash(&m->entries[i].key);                                       \
+                        j = c_internal_hashmap_find_empty(ctrl, capacity - 1, hash);            \
+                        c_internal_hashmap_set_ctrl(ctrl, capacity - 1, j,                      \
+                                                    c_internal_hashmap_h2(hash));               \
+                        entries[j] = m->entries[i];                                             \
+                }                                                                               \
+                                                                                                \
+                free(m->entries);                                                               \
+                m->entries = entries;                                                           \
+                m->ctrl = ctrl;                                                                 \
+                m->mask = capacity - 1;                                                         \
+                return 0;                                                                       \
+        }                                                                                       \
+                                                                                                \
+        static inline size_t c_internal_ ## _name ## _lookup(_name *m,                          \
+                                                             const _key *key,                   \
+                                                             uint64_t hash) {                   \
+                uint8_t h2 = c_internal_hashmap_h2(hash);                                       \
+                size_t i, pos = hash & m->mask;                                                 \
+                unsigned int match;                                                             \
+                                                                                                \
+                for (;;) {                                                                      \
+                        match = c_internal_hashmap_match(m->ctrl + pos, h2);                    \
+                        while (match) {                                                         \
+                                i = (pos + c_internal_hashmap_ctz(match)) & m->mask;            \
+                                if (_c_likely_(_equal(&m->entries[i].key, key)))                \
+                                        return i;                                               \
+                                match &= match - 1;                                             \
+                        }                                                                       \
+                                                                                                \
+                        if (_c_likely_(c_internal_hashmap_match_empty(m->ctrl + pos)))          \
+                                return SIZE_MAX;                                                \
+                                                                                                \
+                        pos = (pos + C_INTERNAL_HASHMAP_GROUP) & m->mask;                       \
+                }                                                                               \
+        }                                                                                       \
+                                                                                                \
+        static inline _value *_name ## _find(_name *m, const _key *key) {                       \
+                size_t i;                                                                       \
+                                                                                                \
+                if (_c_unlikely_(!m->n))                                                        \
+                        return NULL;                                                            \
+                                                                                                \
+                i = c_internal_ ## _name ## _lookup(m, key, _hash(key));                        \
+                return i == SIZE_MAX ? NULL : &m->entries[i].value;                             \
+        }                                                                                       \
+                                                                                                \
+        static inline int _name ## _insert(_name *m, _key key, _value value) {                  \
+                uint64_t hash;                                                                  \
+                size_t i;                                                                       \
+                int r;                                                                          \
+                                                                                                \
+                hash = _hash(&key);                                                             \
+                if (m->n && c_internal_ ## _name ## _lookup(m, &key, hash) != SIZE_MAX)         \
+                        return -EEXIST;                                                         \
+                                                                                                \
+                if (_c_unlikely_(!m->ctrl || m->n >= m->mask + 1 - (m->mask + 1) / 8)) {        \
+                        r = _name ## _reserve(m, m->n + 1);                                     \
+                        if (r)                                                                  \
+                                return r;                                                       \
+                }                                                                               \
+                                                                                                \
+                i = c_internal_hashmap_find_empty(m->ctrl, m->mask, hash);                      \
+                c_internal_hashmap_set_ctrl(m->ctrl, m->mask, i, c_internal_hashmap_h2(hash));  \
+                m->entries[i].key = key;                                                        \
+                m->entries[i].value = value;                                                    \
+                ++m->n;                                                                         \
+                return 0;                                                                       \
+        }                                                                                       \
+                                                                                                \
+        static inline bool _name ## _remove(_name *m, const _key *key, _value *valuep) {        \
+                size_t i, j, home;                                                              \
+                                                                                                \
+                if (!m->n)                                                                      \
+                        return false;                                                           \
+                                                                                                \
+                i = c_internal_ ## _name ## _lookup(m, key, _hash(key));                        \
+                if (i == SIZE_MAX)                                                              \
+                        return false;                                                           \
+                                                                                                \
+                if (valuep)                                                                     \
+                        *valuep = m->entries[i].value;                                          \
+                                                                                                \
+                /*                                                                              \
+                 * Shift following entries back into the hole, unless that                      \
+                 * would move them before their initial position.                               \
+                 */                                                                             \
+                for (j = (i + 1) & m->mask;                                                     \
+                     !(m->ctrl[j] & C_INTERNAL_HASHMAP_EMPTY);                                  \
+                     j = (j + 1) & m->mask) {                                                   \
+                        home = _hash(&m->entries[j].key) & m->mask;                             \
+                        if (((j - home) & m->mask) < ((j - i) & m->mask))                       \
+                                continue;                                                       \
+                                                                                                \
+                        c_internal_hashmap_set_ctrl(m->ctrl, m->mask, i, m->ctrl[j]);           \
+                        m->entries[i] = m->entries[j];                                          \
+                        i = j;                                                                  \
+                }                                                                               \
+                                                                                                \
+                c_internal_hashmap_set_ctrl(m->ctrl, m->mask, i, C_INTERNAL_HASHMAP_EMPTY);     \
+                --m->n;                                                                         \
+                return true;                                                                    \
+        }                                                                                       \
+                                                                                                \
+        static inline _name ## Entry *_name ## _next(_name *m, size_t *iter) {                  \
+                size_t i;                                                                       \
+                                                                                                \
+                for (i = *iter; m->ctrl && i <= m->mask; ++i) {                                 \
+                        if (!(m->ctrl[i] & C_INTERNAL_HASHMAP_EMPTY)) {                         \
+                                *iter = i + 1;                                                  \
+                                return &m->entries[i];                                          \
+                        }                                                                       \
+                }                                                                               \
+                                                                                                \
+                *iter = i;                                                                      \
+                return NULL;                                                                    \
+        }                                                                                       \
+                                                                                                \
+        static inline void _name ## _deinit(_name *m) {                                         \
+                m->entries = c_free(m->entries);                                                \
+                m->ctrl = NULL;                                                                 \
+                m->n = 0;                                                                       \
+                m->mask = 0;                                                                    \
+        }                                                                                       \
+                                                                                                \
+        static inline void _name ## _deinitp(_name *m) {                                        \
+                _name ## _deinit(m);                                                            \
+        }                                                                                       \
+                                                                                                \
+        struct c_internal_trailing_semicolon
 
 /**
  * DOC: Generic Destructors
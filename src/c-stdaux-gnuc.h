@@ -30,6 +30,25 @@ extern "C" {
  */
 /**/
 
+/**
+ * _c_alloc_size_() - Alloc-size attribute
+ * @...:                Argument indices of the size, or of count and size
+ *
+ * Alias for ``__attribute__((__alloc_size__(...)))``. This tells the compiler
+ * the size of the object returned by an allocator, so it can be used for
+ * ``__builtin_object_size()`` and bounds diagnostics.
+ */
+#define _c_alloc_size_(...) __attribute__((__alloc_size__(__VA_ARGS__)))
+
+/**
+ * _c_cacheline_aligned_() - Cache-line alignment attribute
+ *
+ * Alias for ``__attribute__((__aligned__(C_CACHELINE_SIZE)))``. If applied to
+ * a structure member, the member starts on its own cache line, and the size
+ * of the structure is padded to a multiple of the cache line size.
+ */
+#define _c_cacheline_aligned_ __attribute__((__aligned__(C_CACHELINE_SIZE)))
+
 /**
  * _c_cleanup_() - Cleanup attribute
  * @_x:                 Cleanup function to use
@@ -38,6 +57,15 @@ extern "C" {
  */
 #define _c_cleanup_(_x) __attribute__((__cleanup__(_x)))
 
+/**
+ * _c_cold_() - Cold attribute
+ *
+ * Alias for ``__attribute__((__cold__))``. Calls to a cold function are
+ * treated as unlikely, and the function is optimized for size and placed
+ * apart from hot code. Use it for error and slow paths.
+ */
+#define _c_cold_ __attribute__((__cold__))
+
 /**
  * _c_const_() - Const attribute
  *
@@ -52,6 +80,14 @@ extern "C" {
  */
 #define _c_deprecated_ __attribute__((__deprecated__))
 
+/**
+ * _c_flatten_() - Flatten attribute
+ *
+ * Alias for ``__attribute__((__flatten__))``. Every call inside the function
+ * is inlined, if possible.
+ */
+#define _c_flatten_ __attribute__((__flatten__))
+
 /**
  * _c_hidden_() - Hidden attribute
  *
@@ -59,6 +95,40 @@ extern "C" {
  */
 #define _c_hidden_ __attribute__((__visibility__("hidden")))
 
+/**
+ * _c_hot_() - Hot attribute
+ *
+ * Alias for ``__attribute__((__hot__))``. The function is optimized more
+ * aggressively and placed together with other hot code.
+ */
+#define _c_hot_ __attribute__((__hot__))
+
+/**
+ * _c_malloc_() - Malloc attribute
+ *
+ * Alias for ``__attribute__((__malloc__))``. This tells the compiler that the
+ * returned pointer does not alias any other valid pointer, so stores through
+ * it do not force reloads of other objects.
+ */
+#define _c_malloc_ __attribute__((__malloc__))
+
+/**
+ * _c_noinline_() - Noinline attribute
+ *
+ * Alias for ``__attribute__((__noinline__))``.
+ */
+#define _c_noinline_ __attribute__((__noinline__))
+
+/**
+ * _c_nonnull_() - Nonnull attribute
+ * @...:                Indices of the pointer arguments that must not be NULL
+ *
+ * Alias for ``__attribute__((__nonnull__(...)))``. If no index is given, all
+ * pointer arguments must not be NULL. Note that the compiler removes NULL
+ * checks of these arguments inside the function.
+ */
+#define _c_nonnull_(...) __attribute__((__nonnull__(__VA_ARGS__)))
+
 /**
  * _c_packed_() - Packed attribute
  *
@@ -82,6 +152,14 @@ extern "C" {
  */
 #define _c_pure_ __attribute__((__pure__))
 
+/**
+ * _c_returns_nonnull_() - Returns-nonnull attribute
+ *
+ * Alias for ``__attribute__((__returns_nonnull__))``. Callers can drop NULL
+ * checks of the return value.
+ */
+#define _c_returns_nonnull_ __attribute__((__returns_nonnull__))
+
 /**
  * _c_sentinel_() - Sentinel attribute
  *
@@ -218,6 +296,27 @@ _Static_assert(_assertion, _message); \
                         _call(C_VAR(X1, _x1q), C_VAR(X2, _x2q), C_VAR(X3, _x3q), ## __VA_ARGS__);       \
                 }))
 
+/**
+ * C_CACHELINE_PADDED() - Pad type to cache lines
+ * @_type:              Type to pad
+ *
+ * This evaluates to an anonymous structure type with a single member called
+ * ``value`` of type ``_type``. The structure is aligned to, and its size
+ * padded to a multiple of, :c:macro:`C_CACHELINE_SIZE`. Thus, elements of an
+ * array of this type never share a cache line, which avoids false sharing of
+ * per-thread slots:
+ *
+ * .. code-block:: c
+ *
+ *     typedef C_CACHELINE_PADDED(uint64_t) CounterSlot;
+ *     CounterSlot counters[N_THREADS];
+ *
+ *     ++counters[thread_id].value;
+ *
+ * Return: Evaluates to the padded structure type.
+ */
+#define C_CACHELINE_PADDED(_type) struct { _c_cacheline_aligned_ _type value; }
+
 /**
  * DOC: Standard Library Utilities
  *
@@ -365,6 +464,79 @@ static inline void *c_internal_container_of(void *ptr, size_t offset) {
 #define c_less_by(_a, _b) C_CC_MACRO2(C_LESS_BY, (_a), (_b))
 #define C_LESS_BY(_a, _b) ((_a) > (_b) ? (_a) - (_b) : 0)
 
+#define C_INTERNAL_SAT_TYPE(_a, _b) __typeof__((_a) + (_b) + 0u)
+#define C_INTERNAL_SAT(_expr, _a, _b, _name)                                   \
+        C_EXPR_ASSERT(                                                          \
+                (_expr),                                                        \
+                (__typeof__(_a))-1 > 0 && (__typeof__(_b))-1 > 0,               \
+                "Invalid use of " _name "()"                                    \
+        )
+
+/**
+ * c_add_sat() - Saturating addition
+ * @_a:         First summand
+ * @_b:         Second summand
+ *
+ * Calculate ``_a + _b``, but saturate at the maximum of the result type,
+ * rather than wrapping around. Both arguments must be unsigned. The result
+ * type is determined by the usual arithmetic conversions of both arguments,
+ * but is at least ``unsigned int``. This is the counterpart of
+ * :c:macro:`c_less_by()`, which is a saturating subtraction.
+ *
+ * Both arguments are evaluated exactly once, and yield a constant expression
+ * if both are constant. Otherwise, this compiles to the addition followed by
+ * a conditional move.
+ *
+ * Return: ``_a + _b`` is returned, or the maximum of the result type if that
+ *         overflows.
+ */
+#define c_add_sat(_a, _b) C_CC_MACRO2(C_ADD_SAT, (_a), (_b))
+#define C_ADD_SAT(_a, _b)                                                                       \
+        C_INTERNAL_SAT(                                                                         \
+                (C_INTERNAL_SAT_TYPE(_a, _b))((C_INTERNAL_SAT_TYPE(_a, _b))(_a) + (_b)) < (_a)  \
+                        ? (C_INTERNAL_SAT_TYPE(_a, _b))-1                                       \
+                        : (C_INTERNAL_SAT_TYPE(_a, _b))(_a) + (_b),                             \
+                _a,                                                                             \
+                _b,                                                                             \
+                "c_add_sat"                                                                     \
+        )
+
+/**
+ * c_mul_sat() - Saturating multiplication
+ * @_a:         First factor
+ * @_b:         Second factor
+ *
+ * Calculate ``_a * _b``, but saturate at the maximum of the result type,
+ * rather than wrapping around. Both arguments must be unsigned. The result
+ * type is determined by the usual arithmetic conversions of both arguments,
+ * but is at least ``unsigned int``.
+ *
+ * Both arguments are evaluated exactly once, and yield a constant expression
+ * if both are constant. Otherwise, this compiles to the multiplication
+ * followed by a check of the overflow flag.
+ *
+ * Return: ``_a * _b`` is returned, or the maximum of the result type if that
+ *         overflows.
+ */
+#define c_mul_sat(_a, _b) C_CC_MACRO2(C_MUL_SAT, (_a), (_b))
+#define C_MUL_SAT(_a, _b)                                                                       \
+        C_INTERNAL_SAT(                                                                         \
+                __builtin_choose_expr(                                                          \
+                        __builtin_constant_p(_a) && __builtin_constant_p(_b),                   \
+                        ((_b) && (_a) > (C_INTERNAL_SAT_TYPE(_a, _b))-1 / (_b))                 \
+                                ? (C_INTERNAL_SAT_TYPE(_a, _b))-1                               \
+                                : (C_INTERNAL_SAT_TYPE(_a, _b))(_a) * (_b),                     \
+                        __extension__ ({                                                        \
+                                C_INTERNAL_SAT_TYPE(_a, _b) C_VAR(r);                           \
+                                __builtin_mul_overflow((_a), (_b), &C_VAR(r))                   \
+                                        ? (C_INTERNAL_SAT_TYPE(_a, _b))-1                       \
+                                        : C_VAR(r);                                             \
+                        })),                                                                    \
+                _a,                                                                             \
+                _b,                                                                             \
+                "c_mul_sat"                                                                     \
+        )
+
 /**
  * c_clamp() - Clamp value to lower and upper boundary
  * @_x:         Value to clamp
@@ -430,6 +602,640 @@ static inline void *c_internal_container_of(void *ptr, size_t offset) {
 #define c_align_to(_val, _to) C_CC_MACRO2(C_ALIGN_TO, (_val), (_to))
 #define C_ALIGN_TO(_val, _to) (((_val) + (_to) - 1) & ~((_to) - 1))
 
+/**
+ * DOC: Bit Manipulation
+ *
+ * A set of type-generic bit-manipulation helpers is provided. They operate on
+ * unsigned integers of up to 64 bits, and use the width of the type of their
+ * argument (e.g., ``c_clz((uint8_t)1)`` is 7). Note that integer literals and
+ * arithmetic expressions are subject to the usual integer promotions, so cast
+ * them explicitly if a narrower type is intended. Signed arguments are
+ * rejected at compile time.
+ *
+ * Unlike the underlying compiler builtins, all helpers are well-defined for
+ * 0. All arguments are evaluated exactly once, and if all arguments are
+ * constant expressions, the result is constant as well. Otherwise, they lower
+ * to the respective machine instructions, if available.
+ */
+/**/
+
+#define C_INTERNAL_BITS(_x) ((int)(sizeof(_x) * CHAR_BIT))
+#define C_INTERNAL_BITOP(_expr, _x, _name)                                      \
+        C_EXPR_ASSERT(                                                          \
+                (_expr),                                                        \
+                (__typeof__(_x))-1 > 0 && sizeof(_x) <= sizeof(unsigned long long), \
+                "Invalid use of " _name "()"                                    \
+        )
+
+/* clz/ctz for non-zero values, picking the builtin that matches the width */
+#define C_INTERNAL_CLZ(_x)                                                      \
+        __builtin_choose_expr(                                                  \
+                sizeof(_x) <= sizeof(unsigned int),                             \
+                __builtin_clz((unsigned int)(_x)) -                             \
+                        (C_INTERNAL_BITS(unsigned int) - C_INTERNAL_BITS(_x)),  \
+                __builtin_clzll((unsigned long long)(_x)) -                     \
+                        (C_INTERNAL_BITS(unsigned long long) - C_INTERNAL_BITS(_x)))
+#define C_INTERNAL_CTZ(_x)                                                      \
+        __builtin_choose_expr(                                                  \
+                sizeof(_x) <= sizeof(unsigned int),                             \
+                __builtin_ctz((unsigned int)(_x)),                              \
+                __builtin_ctzll((unsigned long long)(_x)))
+
+/**
+ * c_clz() - Count leading zero bits
+ * @_x:         Unsigned integer to operate on
+ *
+ * Return: The number of leading zero bits in ``_x`` is returned. If ``_x`` is
+ *         0, the width of its type is returned.
+ */
+#define c_clz(_x) C_CC_MACRO1(C_CLZ, (_x))
+#define C_CLZ(_x) C_INTERNAL_BITOP((_x) ? C_INTERNAL_CLZ(_x) : C_INTERNAL_BITS(_x), _x, "c_clz")
+
+/**
+ * c_ctz() - Count trailing zero bits
+ * @_x:         Unsigned integer to operate on
+ *
+ * Return: The number of trailing zero bits in ``_x`` is returned. If ``_x``
+ *         is 0, the width of its type is returned.
+ */
+#define c_ctz(_x) C_CC_MACRO1(C_CTZ, (_x))
+#define C_CTZ(_x) C_INTERNAL_BITOP((_x) ? C_INTERNAL_CTZ(_x) : C_INTERNAL_BITS(_x), _x, "c_ctz")
+
+/**
+ * c_popcount() - Count set bits
+ * @_x:         Unsigned integer to operate on
+ *
+ * Return: The number of bits set in ``_x`` is returned.
+ */
+#define c_popcount(_x) C_CC_MACRO1(C_POPCOUNT, (_x))
+#define C_POPCOUNT(_x)                                                          \
+        C_INTERNAL_BITOP(                                                       \
+                __builtin_choose_expr(                                          \
+                        sizeof(_x) <= sizeof(unsigned int),                     \
+                        __builtin_popcount((unsigned int)(_x)),                 \
+                        __builtin_popcountll((unsigned long long)(_x))),        \
+                _x,                                                             \
+                "c_popcount"                                                    \
+        )
+
+/**
+ * c_log2() - Calculate binary logarithm
+ * @_x:         Unsigned integer to operate on
+ *
+ * This calculates the binary logarithm of ``_x``, rounded down. That is, the
+ * index of the most significant bit set in ``_x``. For convenience, 0 is
+ * returned if ``_x`` is 0.
+ *
+ * Return: The binary logarithm of ``_x`` is returned.
+ */
+#define c_log2(_x) C_CC_MACRO1(C_LOG2, (_x))
+#define C_LOG2(_x) C_INTERNAL_BITOP((_x) ? C_INTERNAL_BITS(_x) - 1 - C_INTERNAL_CLZ(_x) : 0, _x, "c_log2")
+
+/**
+ * c_is_pow2() - Check for power of 2
+ * @_x:         Unsigned integer to operate on
+ *
+ * Return: True if ``_x`` is a power of 2, false otherwise (including for 0).
+ */
+#define c_is_pow2(_x) C_CC_MACRO1(C_IS_POW2, (_x))
+#define C_IS_POW2(_x) C_INTERNAL_BITOP((_x) && !((_x) & ((_x) - 1)), _x, "c_is_pow2")
+
+/**
+ * c_next_pow2() - Round up to the next power of 2
+ * @_x:         Unsigned integer to operate on
+ *
+ * This rounds ``_x`` up to the next power of 2. If ``_x`` is a power of 2
+ * already, it is returned unchanged. 0 is rounded up to 1. The result has the
+ * same type as ``_x``. If it cannot be represented in that type, 0 is
+ * returned.
+ *
+ * Return: The smallest power of 2 greater than or equal to ``_x``, or 0.
+ */
+#define c_next_pow2(_x) C_CC_MACRO1(C_NEXT_POW2, (_x))
+/* OR-ing 1 keeps the clz argument non-zero, even in the unused branch */
+#define C_NEXT_POW2(_x)                                                                         \
+        C_INTERNAL_BITOP(                                                                       \
+                (__typeof__(_x))((_x) <= 1 ? 1 : (__typeof__(_x))2 <<                           \
+                        (C_INTERNAL_BITS(_x) - 1 -                                              \
+                         C_INTERNAL_CLZ((__typeof__(_x))(((_x) - 1) | 1)))),                    \
+                _x,                                                                             \
+                "c_next_pow2"                                                                   \
+        )
+
+/**
+ * c_rotl() - Rotate bits left
+ * @_x:         Unsigned integer to operate on
+ * @_n:         Number of bits to rotate by
+ *
+ * This rotates the bits of ``_x`` left by ``_n`` bits, modulo the width of
+ * its type.
+ *
+ * Return: The rotated value is returned, with the same type as ``_x``.
+ */
+#define c_rotl(_x, _n) C_CC_MACRO2(C_ROTL, (_x), (_n))
+#define C_ROTL(_x, _n)                                                                  \
+        C_INTERNAL_BITOP(                                                               \
+                (__typeof__(_x))(                                                       \
+                        ((_x) << ((unsigned int)(_n) & (C_INTERNAL_BITS(_x) - 1))) |    \
+                        ((_x) >> ((0u - (unsigned int)(_n)) & (C_INTERNAL_BITS(_x) - 1)))), \
+                _x,                                                                     \
+                "c_rotl"                                                                \
+        )
+
+/**
+ * c_rotr() - Rotate bits right
+ * @_x:         Unsigned integer to operate on
+ * @_n:         Number of bits to rotate by
+ *
+ * This rotates the bits of ``_x`` right by ``_n`` bits, modulo the width of
+ * its type.
+ *
+ * Return: The rotated value is returned, with the same type as ``_x``.
+ */
+#define c_rotr(_x, _n) C_CC_MACRO2(C_ROTR, (_x), (_n))
+#define C_ROTR(_x, _n)                                                                  \
+        C_INTERNAL_BITOP(                                                               \
+                (__typeof__(_x))(                                                       \
+                        ((_x) >> ((unsigned int)(_n) & (C_INTERNAL_BITS(_x) - 1))) |    \
+                        ((_x) << ((0u - (unsigned int)(_n)) & (C_INTERNAL_BITS(_x) - 1)))), \
+                _x,                                                                     \
+                "c_rotr"                                                                \
+        )
+
+/**
+ * DOC: Memory Arenas
+ *
+ * A memory arena is a bump-pointer allocator. Allocations are served
+ * linearly from large chunks of memory, and cannot be released individually.
+ * Instead, all allocations of an arena are released at once, either when the
+ * arena is destroyed, or when it is reset. Additionally, the state of an arena
+ * can be captured via :c:func:`c_arena_mark()`, and all allocations made
+ * since can be released via :c:func:`c_arena_rewind()`.
+ *
+ * This is suitable for large numbers of short-lived objects with a common
+ * lifetime, like all the objects needed to handle a single request. An
+ * allocation is merely an alignment calculation plus a bounds check, and the
+ * arena integrates with :c:macro:`_c_cleanup_()`:
+ *
+ * .. code-block:: c
+ *
+ *     _c_cleanup_(c_arena_freep) CArena *arena = NULL;
+ *     Foo *foo;
+ *     int r;
+ *
+ *     r = c_arena_new(&arena, 0);
+ *     if (r)
+ *             return r;
+ *
+ *     foo = c_arena_alloc(arena, sizeof(*foo), alignof(Foo));
+ *     if (!foo)
+ *             return -ENOMEM;
+ *
+ * Allocations that do not fit into the current chunk cause a new chunk to be
+ * allocated. Allocations larger than the chunk size of the arena get a
+ * dedicated chunk.
+ *
+ * Arenas are not thread-safe. The caller must serialize access to an arena.
+ */
+/**/
+
+/**
+ * C_ARENA_CHUNK_SIZE - Default chunk size of memory arenas
+ *
+ * This is the chunk size used by :c:func:`c_arena_new()` if no explicit size
+ * is requested. It includes the bookkeeping of each chunk, so the usable
+ * size is slightly smaller.
+ */
+#define C_ARENA_CHUNK_SIZE ((size_t)64 * 1024)
+
+typedef struct CArenaChunk CArenaChunk;
+typedef struct CArenaMark CArenaMark;
+typedef struct CArena CArena;
+
+struct CArenaChunk {
+        CArenaChunk *prev;
+        size_t size;
+        max_align_t data[];
+};
+
+/**
+ * struct CArenaMark - Memory arena position
+ * @chunk:      Current chunk, or NULL
+ * @offset:     Offset into the current chunk
+ *
+ * This captures the allocation state of a :c:struct:`CArena`, as returned by
+ * :c:func:`c_arena_mark()`. All members are private to the implementation.
+ */
+struct CArenaMark {
+        CArenaChunk *chunk;
+        size_t offset;
+};
+
+/**
+ * struct CArena - Memory arena
+ * @chunk:      Current chunk, or NULL
+ * @offset:     Offset into the current chunk
+ * @chunk_size: Allocation size of new chunks
+ *
+ * This is the object backing a memory arena, see
+ * :c:func:`c_arena_new()`. All members are private to the implementation.
+ */
+struct CArena {
+        CArenaChunk *chunk;
+        size_t offset;
+        size_t chunk_size;
+};
+
+/**
+ * c_arena_new() - Create memory arena
+ * @arenap:     Output argument for the new arena
+ * @chunk_size: Chunk size in bytes, or 0 for the default
+ *
+ * Create a new, empty memory arena, and return it in ``arenap``. Memory is
+ * allocated in chunks of ``chunk_size`` bytes (including bookkeeping). If 0,
+ * :c:macro:`C_ARENA_CHUNK_SIZE` is used. No chunk is allocated until the first
+ * allocation is served.
+ *
+ * Return: 0 on success, ``-ENOMEM`` if out of memory.
+ */
+static inline int c_arena_new(CArena **arenap, size_t chunk_size) {
+        CArena *arena;
+
+        arena = malloc(sizeof(*arena));
+        if (!arena)
+                return -ENOMEM;
+
+        *arena = (CArena){
+                .chunk_size = chunk_size ? chunk_size : C_ARENA_CHUNK_SIZE,
+        };
+
+        *arenap = arena;
+        return 0;
+}
+
+/**
+ * c_arena_rewind() - Release all allocations since a mark
+ * @arena:      Arena to operate on
+ * @mark:       Mark to rewind to
+ *
+ * Release all allocations that were made on ``arena`` since ``mark`` was
+ * taken via :c:func:`c_arena_mark()`. The mark must have been taken on the
+ * same arena, and the arena must not have been rewound to an earlier
+ * position, or reset, since.
+ *
+ * Chunks allocated after the mark are released, except that the oldest chunk
+ * of an arena is always retained for reuse.
+ */
+static inline void c_arena_rewind(CArena *arena, CArenaMark mark) {
+        CArenaChunk *chunk;
+
+        while (arena->chunk != mark.chunk && arena->chunk && arena->chunk->prev) {
+                chunk = arena->chunk;
+                arena->chunk = chunk->prev;
+                free(chunk);
+        }
+
+        arena->offset = (arena->chunk == mark.chunk) ? mark.offset : 0;
+}
+
+/**
+ * c_arena_mark() - Capture arena position
+ * @arena:      Arena to operate on
+ *
+ * Return the current allocation position of ``arena``, so it can later be
+ * rewound to it via :c:func:`c_arena_rewind()`. Marks can be nested.
+ *
+ * Return: The current position of the arena is returned.
+ */
+static inline CArenaMark c_arena_mark(CArena *arena) {
+        return (CArenaMark){ .chunk = arena->chunk, .offset = arena->offset };
+}
+
+/**
+ * c_arena_reset() - Release all allocations
+ * @arena:      Arena to operate on
+ *
+ * Release all allocations of ``arena``. The oldest chunk of the arena is
+ * retained and reused for following allocations, all other chunks are
+ * released.
+ */
+static inline void c_arena_reset(CArena *arena) {
+        c_arena_rewind(arena, (CArenaMark){});
+}
+
+/**
+ * c_arena_free() - Destroy memory arena
+ * @arena:      Arena to destroy, or NULL
+ *
+ * Destroy ``arena`` and release all its memory. If ``arena`` is NULL, this is
+ * a no-op.
+ *
+ * Return: NULL is returned.
+ */
+static inline CArena *c_arena_free(CArena *arena) {
+        if (arena) {
+                c_arena_reset(arena);
+                free(arena->chunk);
+                free(arena);
+        }
+
+        return NULL;
+}
+
+static inline void *c_internal_arena_alloc_slow(CArena *arena, size_t size, size_t alignment) {
+        CArenaChunk *chunk;
+        uintptr_t start;
+        size_t n, offset;
+
+        /* dedicated chunk for oversized allocations, otherwise the default */
+        if (c_add_overflow(size, alignment - 1, &n) ||
+            c_add_overflow(n, sizeof(*chunk), &n))
+                return NULL;
+
+        n = c_max(n, arena->chunk_size);
+        chunk = malloc(n);
+        if (!chunk)
+                return NULL;
+
+        chunk->prev = arena->chunk;
+        chunk->size = n - sizeof(*chunk);
+
+        start = (uintptr_t)chunk->data;
+        offset = c_align_to(start, alignment) - start;
+
+        arena->chunk = chunk;
+        arena->offset = offset + size;
+        return (unsigned char *)chunk->data + offset;
+}
+
+/**
+ * c_arena_alloc() - Allocate memory from arena
+ * @arena:      Arena to operate on
+ * @size:       Size of the allocation in bytes
+ * @alignment:  Alignment of the allocation in bytes, must be a power of 2
+ *
+ * Allocate ``size`` bytes from ``arena``, aligned to ``alignment``. The memory
+ * is not initialized. It stays valid until the arena is rewound to an earlier
+ * mark, reset, or destroyed.
+ *
+ * Return: Pointer to the allocated memory, or NULL if out of memory.
+ */
+static inline void *c_arena_alloc(CArena *arena, size_t size, size_t alignment) {
+        uintptr_t start;
+        size_t offset;
+
+        c_assert(c_is_pow2(alignment));
+
+        if (_c_likely_(arena->chunk)) {
+                start = (uintptr_t)arena->chunk->data;
+                offset = c_align_to(start + arena->offset, alignment) - start;
+                if (_c_likely_(offset <= arena->chunk->size &&
+                               size <= arena->chunk->size - offset)) {
+                        arena->offset = offset + size;
+                        return (unsigned char *)arena->chunk->data + offset;
+                }
+        }
+
+        return c_internal_arena_alloc_slow(arena, size, alignment);
+}
+
+/**
+ * c_arena_alloc0() - Allocate zeroed memory from arena
+ * @arena:      Arena to operate on
+ * @size:       Size of the allocation in bytes
+ * @alignment:  Alignment of the allocation in bytes, must be a power of 2
+ *
+ * This works like :c:func:`c_arena_alloc()`, but clears the memory to 0.
+ *
+ * Return: Pointer to the allocated memory, or NULL if out of memory.
+ */
+static inline void *c_arena_alloc0(CArena *arena, size_t size, size_t alignment) {
+        void *p;
+
+        p = c_arena_alloc(arena, size, alignment);
+        if (p)
+                c_memzero(p, size);
+
+        return p;
+}
+
+C_DEFINE_CLEANUP(CArena *, c_arena_free);
+
+/**
+ * DOC: Object Pools
+ *
+ * An object pool serves allocations of a single, fixed object size. Memory is
+ * requested from the system in page-sized slabs, which are carved into objects
+ * lazily, as they are needed. Released objects are kept on an intrusive free
+ * list, which is threaded through the released objects themselves. Both
+ * allocation and release are O(1) and usually just a few instructions.
+ *
+ * Slabs are only returned to the system when the pool is deinitialized. Hence,
+ * a pool should be used for objects with a roughly stable population, like
+ * connection state, timers, or buffers:
+ *
+ * .. code-block:: c
+ *
+ *     _c_cleanup_(c_pool_deinitp) CPool pool = C_POOL_INIT(sizeof(Foo), alignof(Foo));
+ *     Foo *foo;
+ *
+ *     foo = c_pool_alloc(&pool);
+ *     if (!foo)
+ *             return -ENOMEM;
+ *
+ *     [...]
+ *
+ *     foo = c_pool_free(&pool, foo);
+ *
+ * Pools are not thread-safe. The caller must serialize access to a pool, or
+ * use a separate pool per thread.
+ */
+/**/
+
+/**
+ * C_POOL_SLAB_SIZE - Slab size of object pools
+ *
+ * This is the size of the slabs allocated by object pools, including the
+ * bookkeeping of each slab. Objects that do not fit into a slab of this size
+ * get a dedicated slab.
+ */
+#define C_POOL_SLAB_SIZE ((size_t)4096)
+
+typedef struct CPoolEntry CPoolEntry;
+typedef struct CPoolSlab CPoolSlab;
+typedef struct CPool CPool;
+
+struct CPoolEntry {
+        CPoolEntry *next;
+};
+
+struct CPoolSlab {
+        CPoolSlab *next;
+        max_align_t data[];
+};
+
+/**
+ * struct CPool - Object pool
+ * @free_list:          Released objects, ready for reuse
+ * @slabs:              All slabs of this pool
+ * @carve:              Next uncarved object of the current slab
+ * @n_carve:            Number of uncarved objects in the current slab
+ * @object_size:        Size of each object, including alignment padding
+ * @alignment:          Alignment of each object
+ *
+ * This is the object backing an object pool. It is initialized via
+ * :c:macro:`C_POOL_INIT()` or :c:func:`c_pool_init()`. All members are
+ * private to the implementation.
+ */
+struct CPool {
+        CPoolEntry *free_list;
+        CPoolSlab *slabs;
+        unsigned char *carve;
+        size_t n_carve;
+        size_t object_size;
+        size_t alignment;
+};
+
+/**
+ * C_POOL_INIT() - Initialize object pool
+ * @_object_size:       Size of the objects, in bytes
+ * @_alignment:         Alignment of the objects, in bytes, must be a power of 2
+ *
+ * Initialize a new, empty object pool for objects of size ``_object_size``.
+ * No memory is allocated until the first object is allocated. If both
+ * arguments are constant, this can be used for static initializers.
+ *
+ * Return: The initializer of the object pool is returned.
+ */
+#define C_POOL_INIT(_object_size, _alignment) {                                                 \
+                .object_size = c_align_to(                                                      \
+                        c_max((size_t)(_object_size), sizeof(CPoolEntry)),                      \
+                        c_max((size_t)(_alignment), alignof(CPoolEntry))                        \
+                ),                                                                              \
+                .alignment = c_max((size_t)(_alignment), alignof(CPoolEntry)),                  \
+        }
+
+/**
+ * c_pool_init() - Initialize object pool
+ * @pool:               Object pool to initialize
+ * @object_size:        Size of the objects, in bytes
+ * @alignment:          Alignment of the objects, in bytes, must be a power of 2
+ *
+ * This is the runtime equivalent of :c:macro:`C_POOL_INIT()`.
+ */
+static inline void c_pool_init(CPool *pool, size_t object_size, size_t alignment) {
+        c_assert(c_is_pow2(alignment));
+        *pool = (CPool)C_POOL_INIT(object_size, alignment);
+}
+
+/**
+ * c_pool_deinit() - Deinitialize object pool
+ * @pool:               Object pool to deinitialize
+ *
+ * Deinitialize ``pool`` and return all its memory to the system. All objects
+ * allocated from the pool become invalid, regardless of whether they were
+ * released. Afterwards, the pool is empty and can be used again.
+ */
+static inline void c_pool_deinit(CPool *pool) {
+        CPoolSlab *slab;
+
+        while ((slab = pool->slabs)) {
+                pool->slabs = slab->next;
+                free(slab);
+        }
+
+        pool->free_list = NULL;
+        pool->carve = NULL;
+        pool->n_carve = 0;
+}
+
+static inline void *c_internal_pool_alloc_slow(CPool *pool) {
+        CPoolSlab *slab;
+        uintptr_t start;
+        size_t n, offset;
+        void *object;
+
+        /* the object size wraps to 0 if it overflowed during initialization */
+        if (!pool->object_size ||
+            c_add_overflow(pool->object_size, pool->alignment - 1, &n) ||
+            c_add_overflow(n, sizeof(*slab), &n))
+                return NULL;
+
+        n = c_max(n, C_POOL_SLAB_SIZE);
+        slab = malloc(n);
+        if (!slab)
+                return NULL;
+
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+
+        start = (uintptr_t)slab->data;
+        offset = c_align_to(start, pool->alignment) - start;
+        n -= sizeof(*slab) + offset;
+
+        object = (unsigned char *)slab->data + offset;
+        pool->carve = (unsigned char *)object + pool->object_size;
+        pool->n_carve = n / pool->object_size - 1;
+        return object;
+}
+
+/**
+ * c_pool_alloc() - Allocate object from pool
+ * @pool:               Object pool to operate on
+ *
+ * Allocate a single object from ``pool``. The memory of the object is not
+ * initialized. Released objects are reused first, most recently released
+ * objects first. Then, the current slab is carved further, and only if it is
+ * exhausted, a new slab is allocated.
+ *
+ * Return: Pointer to the new object, or NULL if out of memory.
+ */
+static inline void *c_pool_alloc(CPool *pool) {
+        CPoolEntry *entry;
+        void *object;
+
+        entry = pool->free_list;
+        if (_c_likely_(entry)) {
+                pool->free_list = entry->next;
+                return entry;
+        }
+
+        if (_c_likely_(pool->n_carve)) {
+                object = pool->carve;
+                pool->carve += pool->object_size;
+                --pool->n_carve;
+                return object;
+        }
+
+        return c_internal_pool_alloc_slow(pool);
+}
+
+/**
+ * c_pool_free() - Release object to pool
+ * @pool:               Object pool to operate on
+ * @object:             Object to release, or NULL
+ *
+ * Release ``object`` to the pool it was allocated from. It is put on the free
+ * list of the pool, and will be reused by the next allocation. If ``object``
+ * is NULL, this is a no-op.
+ *
+ * Return: NULL is returned.
+ */
+static inline void *c_pool_free(CPool *pool, void *object) {
+        CPoolEntry *entry = object;
+
+        if (object) {
+                entry->next = pool->free_list;
+                pool->free_list = entry;
+        }
+
+        return NULL;
+}
+
+static inline void c_pool_deinitp(CPool *pool) {
+        c_pool_deinit(pool);
+}
+
 #ifdef __cplusplus
 }
 #endif
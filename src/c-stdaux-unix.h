@@ -27,10 +27,18 @@ extern "C" {
 
 #include <dirent.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#if defined(C_OS_LINUX)
+#  include <sys/sendfile.h>
+#  include <sys/syscall.h>
+#endif
+
 /**
  * DOC: Common Unix Destructors
  *
@@ -78,6 +86,972 @@ static inline DIR *c_closedir(DIR *d) {
         return NULL;
 }
 
+/**
+ * DOC: Full-Length I/O
+ *
+ * The ``read(2)`` and ``write(2)`` family of system calls can transfer less
+ * than requested, and can be interrupted by signals. The helpers in this
+ * section loop until the entire request is transferred, retrying on ``EINTR``
+ * and resuming after short transfers. All of them return 0 on success, or a
+ * negative error code on failure. The number of bytes transferred is returned
+ * via an optional output argument, which is valid on failure as well, so
+ * callers can tell how far the transfer got (e.g., on ``-EAGAIN`` for
+ * non-blocking file descriptors).
+ *
+ * The vectored variants transfer an entire array of buffers with as few
+ * system calls as possible. This is the preferred way to write many small
+ * buffers, since the system call is usually the dominating cost.
+ */
+/**/
+
+#if defined(IOV_MAX)
+#  define C_INTERNAL_IOV_MAX IOV_MAX
+#else
+#  define C_INTERNAL_IOV_MAX 1024
+#endif
+
+/**
+ * c_read_full() - Read until buffer is full or end-of-file
+ * @fd:                 File descriptor to read from
+ * @buf:                Buffer to read into
+ * @n:                  Number of bytes to read
+ * @n_readp:            Output argument for the number of bytes read, or NULL
+ *
+ * Read ``n`` bytes from ``fd`` into ``buf``, looping on short reads and
+ * ``EINTR``. Reading stops early if the end of the file is reached, which is
+ * not an error. Compare the number of bytes read to ``n`` to detect it.
+ *
+ * Return: 0 on success, negative error code on failure.
+ */
+static inline int c_read_full(int fd, void *buf, size_t n, size_t *n_readp) {
+        size_t pos = 0;
+        ssize_t l;
+        int r = 0;
+
+        while (pos < n) {
+                l = read(fd, (char *)buf + pos, n - pos > SSIZE_MAX ? SSIZE_MAX : n - pos);
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        r = -c_errno();
+                        break;
+                } else if (l == 0) {
+                        break;
+                }
+
+                pos += (size_t)l;
+        }
+
+        if (n_readp)
+                *n_readp = pos;
+        return r;
+}
+
+/**
+ * c_write_full() - Write entire buffer
+ * @fd:                 File descriptor to write to
+ * @buf:                Buffer to write
+ * @n:                  Number of bytes to write
+ * @n_writtenp:         Output argument for the number of bytes written, or
+ *                      NULL
+ *
+ * Write all ``n`` bytes of ``buf`` to ``fd``, looping on short writes and
+ * ``EINTR``.
+ *
+ * Return: 0 on success, negative error code on failure.
+ */
+static inline int c_write_full(int fd, const void *buf, size_t n, size_t *n_writtenp) {
+        size_t pos = 0;
+        ssize_t l;
+        int r = 0;
+
+        while (pos < n) {
+                l = write(fd, (const char *)buf + pos, n - pos > SSIZE_MAX ? SSIZE_MAX : n - pos);
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        r = -c_errno();
+                        break;
+                } else if (l == 0) {
+                        /* cannot happen for regular files, avoid looping */
+                        r = -EIO;
+                        break;
+                }
+
+                pos += (size_t)l;
+        }
+
+        if (n_writtenp)
+                *n_writtenp = pos;
+        return r;
+}
+
+/*
+ * Skip fully transferred buffers, and advance the first partially transferred
+ * one. Returns the new index of the first buffer with data left.
+ */
+static inline size_t c_internal_iovec_advance(struct iovec *iov, size_t n_iov, size_t i, size_t n) {
+        for ( ; i < n_iov; ++i) {
+                if (n < iov[i].iov_len) {
+                        iov[i].iov_base = (char *)iov[i].iov_base + n;
+                        iov[i].iov_len -= n;
+                        break;
+                }
+
+                n -= iov[i].iov_len;
+        }
+
+        /* skip empty buffers, so end-of-file is detected reliably */
+        while (i < n_iov && !iov[i].iov_len)
+                ++i;
+
+        return i;
+}
+
+/**
+ * c_readv_full() - Read until all buffers are full or end-of-file
+ * @fd:                 File descriptor to read from
+ * @iov:                Array of buffers to read into
+ * @n_iov:              Number of buffers
+ * @n_readp:            Output argument for the number of bytes read, or NULL
+ *
+ * This is the vectored version of :c:func:`c_read_full()`. It fills the
+ * buffers in order, transferring up to ``IOV_MAX`` buffers per system call.
+ *
+ * To resume after short reads, the entries of ``iov`` are advanced in place.
+ * Their content is unspecified when this returns.
+ *
+ * Return: 0 on success, negative error code on failure.
+ */
+static inline int c_readv_full(int fd, struct iovec *iov, size_t n_iov, size_t *n_readp) {
+        size_t i, pos = 0;
+        ssize_t l;
+        int r = 0;
+
+        i = c_internal_iovec_advance(iov, n_iov, 0, 0);
+        while (i < n_iov) {
+                l = readv(fd, iov + i, (int)(n_iov - i > C_INTERNAL_IOV_MAX ? C_INTERNAL_IOV_MAX : n_iov - i));
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        r = -c_errno();
+                        break;
+                } else if (l == 0) {
+                        break;
+                }
+
+                pos += (size_t)l;
+                i = c_internal_iovec_advance(iov, n_iov, i, (size_t)l);
+        }
+
+        if (n_readp)
+                *n_readp = pos;
+        return r;
+}
+
+/**
+ * c_writev_full() - Write all buffers
+ * @fd:                 File descriptor to write to
+ * @iov:                Array of buffers to write
+ * @n_iov:              Number of buffers
+ * @n_writtenp:         Output argument for the number of bytes written, or
+ *                      NULL
+ *
+ * This is the vectored version of :c:func:`c_write_full()`. It writes the
+ * buffers in order, transferring up to ``IOV_MAX`` buffers per system call.
+ * Thus, many small buffers are usually written with a single system call.
+ *
+ * To resume after short writes, the entries of ``iov`` are advanced in place.
+ * Their content is unspecified when this returns.
+ *
+ * Return: 0 on success, negative error code on failure.
+ */
+static inline int c_writev_full(int fd, struct iovec *iov, size_t n_iov, size_t *n_writtenp) {
+        size_t i, pos = 0;
+        ssize_t l;
+        int r = 0;
+
+        i = c_internal_iovec_advance(iov, n_iov, 0, 0);
+        while (i < n_iov) {
+                l = writev(fd, iov + i, (int)(n_iov - i > C_INTERNAL_IOV_MAX ? C_INTERNAL_IOV_MAX : n_iov - i));
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        r = -c_errno();
+                        break;
+                } else if (l == 0) {
+                        /* cannot happen for regular files, avoid looping */
+                        r = -EIO;
+                        break;
+                }
+
+                pos += (size_t)l;
+                i = c_internal_iovec_advance(iov, n_iov, i, (size_t)l);
+        }
+
+        if (n_writtenp)
+                *n_writtenp = pos;
+        return r;
+}
+
+/**
+ * DOC: Mapped Files
+ *
+ * A :c:struct:`CFileMap` is a memory mapping of an entire file. Compared to
+ * reading a file into an allocated buffer, the data is not copied, pages are
+ * shared with the page cache, and only pages that are actually accessed are
+ * loaded. This makes it the preferred way to access large read-mostly files.
+ *
+ * The following flags are supported by :c:func:`c_file_map_new()`:
+ *
+ * - ``C_FILE_MAP_WRITABLE``: Open the file for writing and map it shared and
+ *   writable. Writes to the mapping are written back to the file.
+ * - ``C_FILE_MAP_SEQUENTIAL``: Advise the kernel that the mapping will be
+ *   accessed sequentially, enabling aggressive read-ahead.
+ * - ``C_FILE_MAP_RANDOM``: Advise the kernel that the mapping will be
+ *   accessed randomly, disabling read-ahead.
+ * - ``C_FILE_MAP_WILLNEED``: Advise the kernel to start reading the entire
+ *   file in the background.
+ * - ``C_FILE_MAP_POPULATE``: Read the entire file and populate the page
+ *   tables before returning, so no page faults are taken later on. This is
+ *   only supported on Linux, other systems fall back to
+ *   ``C_FILE_MAP_WILLNEED``.
+ *
+ * Access advice is a hint, failure to apply it is silently ignored.
+ */
+/**/
+
+#define C_FILE_MAP_WRITABLE     (1U << 0)
+#define C_FILE_MAP_SEQUENTIAL   (1U << 1)
+#define C_FILE_MAP_RANDOM       (1U << 2)
+#define C_FILE_MAP_WILLNEED     (1U << 3)
+#define C_FILE_MAP_POPULATE     (1U << 4)
+
+/**
+ * struct CFileMap - Mapped file
+ * @data:               Mapped file content, or NULL if the file is empty
+ * @size:               Size of the file in bytes
+ *
+ * This describes a mapping of an entire file. It is created via
+ * :c:func:`c_file_map_new()`. Both members are public, but must not be
+ * modified.
+ */
+typedef struct CFileMap {
+        void *data;
+        size_t size;
+} CFileMap;
+
+static inline int c_internal_file_map_fd(CFileMap *map, int fd, unsigned int flags) {
+        int mmap_flags = MAP_SHARED, prot = PROT_READ;
+        struct stat st;
+        int r;
+
+        r = fstat(fd, &st);
+        if (r < 0)
+                return -c_errno();
+        if (!S_ISREG(st.st_mode))
+                return -EINVAL;
+        if ((uintmax_t)st.st_size > SIZE_MAX)
+                return -EFBIG;
+
+        map->data = NULL;
+        map->size = (size_t)st.st_size;
+        if (!map->size)
+                return 0;
+
+        if (flags & C_FILE_MAP_WRITABLE)
+                prot |= PROT_WRITE;
+#if defined(MAP_POPULATE)
+        if (flags & C_FILE_MAP_POPULATE)
+                mmap_flags |= MAP_POPULATE;
+#else
+        if (flags & C_FILE_MAP_POPULATE)
+                flags |= C_FILE_MAP_WILLNEED;
+#endif
+
+        map->data = mmap(NULL, map->size, prot, mmap_flags, fd, 0);
+        if (map->data == MAP_FAILED) {
+                map->data = NULL;
+                return -c_errno();
+        }
+
+        if (flags & C_FILE_MAP_SEQUENTIAL)
+                posix_madvise(map->data, map->size, POSIX_MADV_SEQUENTIAL);
+        if (flags & C_FILE_MAP_RANDOM)
+                posix_madvise(map->data, map->size, POSIX_MADV_RANDOM);
+        if (flags & C_FILE_MAP_WILLNEED)
+                posix_madvise(map->data, map->size, POSIX_MADV_WILLNEED);
+
+        return 0;
+}
+
+/**
+ * c_file_map_new() - Map file into memory
+ * @mapp:               Output argument for the new mapping
+ * @path:               Path of the file to map
+ * @flags:              Mapping flags
+ *
+ * Open the regular file at ``path``, and map its entire content into memory.
+ * The file descriptor is not kept open. See the section description for the
+ * supported flags. The mapping covers the size of the file at the time of
+ * this call. If the file is truncated later, accessing the truncated part
+ * raises ``SIGBUS``.
+ *
+ * Empty files are supported, the mapping has no data in that case.
+ *
+ * Return: 0 on success, ``-EINVAL`` if ``path`` is not a regular file,
+ *         ``-EFBIG`` if the file is too big to be mapped, ``-ENOMEM`` if out
+ *         of memory, or another negative error code if opening or mapping
+ *         the file failed.
+ */
+static inline int c_file_map_new(CFileMap **mapp, const char *path, unsigned int flags) {
+        CFileMap *map;
+        int r, fd;
+
+        map = malloc(sizeof(*map));
+        if (!map)
+                return -ENOMEM;
+
+        fd = open(path, (flags & C_FILE_MAP_WRITABLE ? O_RDWR : O_RDONLY) | O_CLOEXEC | O_NOCTTY);
+        if (fd < 0) {
+                r = -c_errno();
+                free(map);
+                return r;
+        }
+
+        r = c_internal_file_map_fd(map, fd, flags);
+        c_close(fd);
+        if (r < 0) {
+                free(map);
+                return r;
+        }
+
+        *mapp = map;
+        return 0;
+}
+
+/**
+ * c_file_map_free() - Unmap file
+ * @map:                Mapping to destroy, or NULL
+ *
+ * Unmap the file and destroy ``map``. Pending writes of writable mappings are
+ * written back by the kernel eventually, use ``msync(2)`` before this call
+ * to wait for them. If ``map`` is NULL, this is a no-op.
+ *
+ * Return: NULL is returned.
+ */
+static inline CFileMap *c_file_map_free(CFileMap *map) {
+        if (map) {
+                if (map->data)
+                        munmap(map->data, map->size);
+                free(map);
+        }
+        return NULL;
+}
+
+/**
+ * DOC: Copying File Descriptors
+ *
+ * :c:func:`c_copy_fd()` copies data between two file descriptors. On Linux,
+ * it avoids copying the data through user-space, if possible. It tries, in
+ * order, ``copy_file_range(2)`` (file to file, possibly sharing extents),
+ * ``sendfile(2)`` (file to anything), and ``splice(2)`` through a pipe (for
+ * anything else). Each of them is only used if supported for the given file
+ * descriptors, and the next one is tried otherwise. As a last resort, and on
+ * other systems, the data is copied via a read/write loop.
+ */
+/**/
+
+#define C_INTERNAL_COPY_CHUNK (1U << 30)
+#define C_INTERNAL_COPY_BUFFER (64U * 1024U)
+
+static inline size_t c_internal_copy_chunk(size_t n, size_t pos) {
+        return n - pos < C_INTERNAL_COPY_CHUNK ? n - pos : C_INTERNAL_COPY_CHUNK;
+}
+
+/*
+ * The copy helpers below return 0 when done (either ``n`` bytes were copied,
+ * or end-of-file was reached), 1 if the method is not supported for the file
+ * descriptors and the next one shall be tried, or a negative error code.
+ * ``*posp`` is advanced by the number of bytes written to ``fd_out``.
+ */
+
+static inline int c_internal_copy_fd_buffered(int fd_in, int fd_out, size_t n, size_t *posp) {
+        size_t n_buffer, n_written;
+        void *buffer;
+        ssize_t l;
+        int r = 0;
+
+        if (*posp >= n)
+                return 0;
+
+        n_buffer = n - *posp < C_INTERNAL_COPY_BUFFER ? n - *posp : C_INTERNAL_COPY_BUFFER;
+        buffer = malloc(n_buffer);
+        if (!buffer)
+                return -ENOMEM;
+
+        while (*posp < n) {
+                l = read(fd_in, buffer, n - *posp < n_buffer ? n - *posp : n_buffer);
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        r = -c_errno();
+                        break;
+                } else if (l == 0) {
+                        break;
+                }
+
+                r = c_write_full(fd_out, buffer, (size_t)l, &n_written);
+                *posp += n_written;
+                if (r < 0)
+                        break;
+        }
+
+        free(buffer);
+        return r;
+}
+
+#if defined(C_OS_LINUX)
+
+static inline bool c_internal_copy_fd_unsupported(int error) {
+        /* EBADF is returned for O_APPEND, a real EBADF is caught later on */
+        return error == ENOSYS ||
+               error == EINVAL ||
+               error == EXDEV ||
+               error == EOPNOTSUPP ||
+               error == EBADF;
+}
+
+static inline int c_internal_copy_fd_range(int fd_in, int fd_out, size_t n, size_t *posp) {
+#if defined(__NR_copy_file_range)
+        ssize_t l;
+
+        while (*posp < n) {
+                l = syscall(__NR_copy_file_range, fd_in, NULL, fd_out, NULL, c_internal_copy_chunk(n, *posp), 0U);
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        return c_internal_copy_fd_unsupported(errno) ? 1 : -c_errno();
+                } else if (l == 0) {
+                        /* pseudo-files can report end-of-file here, so verify it */
+                        return *posp ? 0 : 1;
+                }
+
+                *posp += (size_t)l;
+        }
+
+        return 0;
+#else
+        return 1;
+#endif
+}
+
+static inline int c_internal_copy_fd_sendfile(int fd_in, int fd_out, size_t n, size_t *posp) {
+        ssize_t l;
+
+        while (*posp < n) {
+                l = sendfile(fd_out, fd_in, NULL, c_internal_copy_chunk(n, *posp));
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        return c_internal_copy_fd_unsupported(errno) ? 1 : -c_errno();
+                } else if (l == 0) {
+                        return 0;
+                }
+
+                *posp += (size_t)l;
+        }
+
+        return 0;
+}
+
+static inline int c_internal_copy_fd_splice(int fd_in, int fd_out, size_t n, size_t *posp) {
+#if defined(__NR_splice)
+        size_t n_pipe, n_written;
+        char buffer[4096];
+        int r = 0, p[2];
+        ssize_t l;
+
+        if (*posp >= n)
+                return 0;
+
+        r = pipe2(p, O_CLOEXEC);
+        if (r < 0)
+                return c_internal_copy_fd_unsupported(errno) ? 1 : -c_errno();
+
+        while (*posp < n) {
+                l = syscall(__NR_splice, fd_in, NULL, p[1], NULL, c_internal_copy_chunk(n, *posp), 0U);
+                if (l < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        r = c_internal_copy_fd_unsupported(errno) ? 1 : -c_errno();
+                        break;
+                } else if (l == 0) {
+                        break;
+                }
+
+                for (n_pipe = (size_t)l; n_pipe; ) {
+                        l = syscall(__NR_splice, p[0], NULL, fd_out, NULL, n_pipe, 0U);
+                        if (l < 0) {
+                                if (errno == EINTR)
+                                        continue;
+                                r = c_internal_copy_fd_unsupported(errno) ? 1 : -c_errno();
+                                break;
+                        }
+
+                        *posp += (size_t)l;
+                        n_pipe -= (size_t)l;
+                }
+
+                if (r > 0) {
+                        /* the output side is unsupported, drain the pipe manually */
+                        while (n_pipe) {
+                                l = read(p[0], buffer, n_pipe < sizeof(buffer) ? n_pipe : sizeof(buffer));
+                                if (l < 0) {
+                                        if (errno == EINTR)
+                                                continue;
+                                        r = -c_errno();
+                                        break;
+                                }
+
+                                r = c_write_full(fd_out, buffer, (size_t)l, &n_written);
+                                *posp += n_written;
+                                n_pipe -= (size_t)l;
+                                if (r < 0)
+                                        break;
+                                r = 1;
+                        }
+                }
+
+                if (r)
+                        break;
+        }
+
+        c_close(p[0]);
+        c_close(p[1]);
+        return r;
+#else
+        return 1;
+#endif
+}
+
+#endif /* C_OS_LINUX */
+
+/**
+ * c_copy_fd() - Copy data between file descriptors
+ * @fd_in:              File descriptor to copy from
+ * @fd_out:             File descriptor to copy to
+ * @n:                  Maximum number of bytes to copy, or ``SIZE_MAX``
+ * @n_copiedp:          Output argument for the number of bytes copied, or
+ *                      NULL
+ *
+ * Copy up to ``n`` bytes from ``fd_in`` to ``fd_out``, starting at their
+ * current file offsets (which are advanced accordingly). Copying stops early
+ * if the end of ``fd_in`` is reached, which is not an error. Pass
+ * ``SIZE_MAX`` to copy everything up to the end. Interruptions by signals and
+ * short transfers are handled internally.
+ *
+ * The number of bytes written to ``fd_out`` is returned via ``n_copiedp``,
+ * which is valid on failure as well.
+ *
+ * Return: 0 on success, negative error code on failure.
+ */
+static inline int c_copy_fd(int fd_in, int fd_out, size_t n, size_t *n_copiedp) {
+        size_t pos = 0;
+        int r = 1;
+
+#if defined(C_OS_LINUX)
+        r = c_internal_copy_fd_range(fd_in, fd_out, n, &pos);
+        if (r > 0)
+                r = c_internal_copy_fd_sendfile(fd_in, fd_out, n, &pos);
+        if (r > 0)
+                r = c_internal_copy_fd_splice(fd_in, fd_out, n, &pos);
+#endif
+        if (r > 0)
+                r = c_internal_copy_fd_buffered(fd_in, fd_out, n, &pos);
+
+        if (n_copiedp)
+                *n_copiedp = pos;
+        return r;
+}
+
+/**
+ * DOC: Closing File Descriptor Ranges
+ *
+ * :c:func:`c_close_range()` and :c:func:`c_closefrom()` close all file
+ * descriptors in a range, which is usually needed before executing another
+ * program. On Linux, they use the ``close_range(2)`` system call. If it is not
+ * available, the open file descriptors are enumerated via ``/proc/self/fd``
+ * (``/dev/fd`` on MacOS), so only those are closed. Only if that fails as
+ * well, every possible file descriptor up to the limit of the process is
+ * closed individually, which is slow with high limits.
+ *
+ * On Linux, all of this is async-signal-safe and does not allocate memory, so
+ * it can be used in the child after ``fork(2)`` of a multi-threaded process.
+ * On MacOS, ``/dev/fd`` is enumerated via ``opendir(3)``, which allocates
+ * memory, so it must not be used in such a child.
+ */
+/**/
+
+static inline void c_internal_close_range_all(int first, int last) {
+        long max;
+        int fd;
+
+        max = sysconf(_SC_OPEN_MAX);
+        if (max < 0 || max > INT_MAX)
+                max = INT_MAX;
+        if (last > max - 1)
+                last = (int)(max - 1);
+
+        for (fd = first; fd <= last; ++fd)
+                close(fd);
+}
+
+#if defined(C_OS_LINUX)
+
+/* record layout returned by getdents64(2) */
+typedef struct CInternalDirent64 {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[];
+} CInternalDirent64;
+
+/* parse a file-descriptor number without allocating, or return -1 */
+static inline int c_internal_close_range_parse(const char *name) {
+        int fd = 0;
+
+        if (!*name)
+                return -1;
+
+        for ( ; *name; ++name) {
+                if (*name < '0' || *name > '9' || fd > (INT_MAX - 9) / 10)
+                        return -1;
+                fd = fd * 10 + (*name - '0');
+        }
+
+        return fd;
+}
+
+static inline int c_internal_close_range_dir(int first, int last) {
+        uint64_t buffer[512];
+        CInternalDirent64 *de;
+        int r, fd, dfd;
+        long i, l;
+
+        /* stay async-signal-safe: no allocation, no stdio, no DIR */
+        dfd = open("/proc/self/fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dfd < 0)
+                return -c_errno();
+
+        while ((l = syscall(SYS_getdents64, dfd, buffer, sizeof(buffer))) > 0) {
+                for (i = 0; i < l; i += de->d_reclen) {
+                        de = (CInternalDirent64 *)((unsigned char *)buffer + i);
+                        fd = c_internal_close_range_parse(de->d_name);
+                        if (fd >= first && fd <= last && fd != dfd)
+                                close(fd);
+                }
+        }
+
+        r = l < 0 ? -c_errno() : 0;
+        c_close(dfd);
+        return r;
+}
+
+#else
+
+static inline int c_internal_close_range_dir(int first, int last) {
+        struct dirent *de;
+        char *end;
+        long fd;
+        DIR *d;
+
+        d = opendir("/dev/fd");
+        if (!d)
+                return -c_errno();
+
+        while ((de = readdir(d))) {
+                errno = 0;
+                fd = strtol(de->d_name, &end, 10);
+                if (errno || *end || end == de->d_name)
+                        continue;
+
+                if (fd >= first && fd <= last && fd != dirfd(d))
+                        close((int)fd);
+        }
+
+        c_closedir(d);
+        return 0;
+}
+
+#endif
+
+/**
+ * c_close_range() - Close range of file descriptors
+ * @first:              First file descriptor to close
+ * @last:               Last file descriptor to close
+ *
+ * Close all open file descriptors from ``first`` to ``last``, inclusive.
+ * Errors of individual ``close(2)`` calls are ignored, like with
+ * :c:func:`c_close()`.
+ *
+ * Return: 0 on success, ``-EINVAL`` if the range is invalid.
+ */
+static inline int c_close_range(int first, int last) {
+        int r;
+
+        if (first < 0 || last < first)
+                return -EINVAL;
+
+#if defined(C_OS_LINUX) && defined(__NR_close_range)
+        r = (int)syscall(__NR_close_range, (unsigned int)first, (unsigned int)last, 0U);
+        if (r >= 0)
+                return 0;
+#endif
+
+        r = c_internal_close_range_dir(first, last);
+        if (r < 0)
+                c_internal_close_range_all(first, last);
+
+        return 0;
+}
+
+/**
+ * c_closefrom() - Close all file descriptors from a given number on
+ * @first:              First file descriptor to close
+ *
+ * Close all open file descriptors greater than or equal to ``first``. This is
+ * equivalent to ``c_close_range(first, INT_MAX)``.
+ *
+ * Return: 0 on success, ``-EINVAL`` if ``first`` is negative.
+ */
+static inline int c_closefrom(int first) {
+        return c_close_range(first, INT_MAX);
+}
+
+/**
+ * DOC: Directory Iterators
+ *
+ * A :c:struct:`CDirIter` enumerates the entries of a directory. Unlike
+ * ``readdir(3)``, it does not need a ``DIR`` object, and on Linux it reads
+ * entries in large batches via ``getdents64(2)``, so large directories need
+ * few system calls. Every entry carries the file type as reported by the
+ * file system, so callers can often avoid calling ``stat(2)`` on each entry.
+ * If more attributes are needed, :c:func:`c_dir_iter_stat()` fetches them
+ * relative to the open directory, without resolving the full path again.
+ *
+ * On other systems, the iterator is backed by ``readdir(3)``.
+ */
+/**/
+
+#define C_INTERNAL_DIR_ITER_BUFFER (64 * 1024)
+
+/**
+ * struct CDirEntry - Directory entry
+ * @name:               Name of the entry
+ * @ino:                Inode number of the entry
+ * @type:               File type of the entry (``DT_*``)
+ *
+ * This describes a single entry returned by :c:func:`c_dir_iter_next()`. It
+ * is only valid until the next call on the same iterator. ``type`` is
+ * ``DT_UNKNOWN`` if the file system does not report file types, in which case
+ * :c:func:`c_dir_iter_stat()` must be used to get it.
+ */
+typedef struct CDirEntry {
+        const char *name;
+        uint64_t ino;
+        unsigned char type;
+} CDirEntry;
+
+/**
+ * struct CDirIter - Directory iterator
+ * @fd:                 File descriptor of the directory
+ *
+ * This iterates the entries of a directory. It is created via
+ * :c:func:`c_dir_iter_new()`. ``fd`` is public and can be used with the
+ * ``*at()`` family of system calls, but it is owned by the iterator and must
+ * not be closed or read from. All other members are private.
+ */
+typedef struct CDirIter {
+        int fd;
+        CDirEntry entry;
+#if defined(C_OS_LINUX)
+        size_t i_buffer;
+        size_t n_buffer;
+        uint64_t buffer[C_INTERNAL_DIR_ITER_BUFFER / sizeof(uint64_t)];
+#else
+        DIR *dir;
+#endif
+} CDirIter;
+
+static inline bool c_internal_dir_is_dot(const char *name) {
+        return name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2]));
+}
+
+/**
+ * c_dir_iter_new() - Open directory for iteration
+ * @iterp:              Output argument for the new iterator
+ * @dirfd:              Directory to resolve ``path`` relative to, or
+ *                      ``AT_FDCWD``
+ * @path:               Path of the directory to iterate
+ *
+ * Open the directory at ``path`` and create an iterator for its entries. If
+ * ``path`` is relative, it is resolved relative to ``dirfd``, like with
+ * ``openat(2)``.
+ *
+ * Return: 0 on success, ``-ENOTDIR`` if ``path`` is not a directory,
+ *         ``-ENOMEM`` if out of memory, or another negative error code if
+ *         opening the directory failed.
+ */
+static inline int c_dir_iter_new(CDirIter **iterp, int dirfd, const char *path) {
+        CDirIter *iter;
+        int r;
+
+        iter = malloc(sizeof(*iter));
+        if (!iter)
+                return -ENOMEM;
+
+        iter->fd = openat(dirfd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOCTTY);
+        if (iter->fd < 0) {
+                r = -c_errno();
+                free(iter);
+                return r;
+        }
+
+#if defined(C_OS_LINUX)
+        iter->i_buffer = 0;
+        iter->n_buffer = 0;
+#else
+        iter->dir = fdopendir(iter->fd);
+        if (!iter->dir) {
+                r = -c_errno();
+                c_close(iter->fd);
+                free(iter);
+                return r;
+        }
+#endif
+
+        *iterp = iter;
+        return 0;
+}
+
+/**
+ * c_dir_iter_free() - Close directory iterator
+ * @iter:               Iterator to destroy, or NULL
+ *
+ * Close the directory and destroy ``iter``. If ``iter`` is NULL, this is a
+ * no-op.
+ *
+ * Return: NULL is returned.
+ */
+static inline CDirIter *c_dir_iter_free(CDirIter *iter) {
+        if (iter) {
+#if defined(C_OS_LINUX)
+                c_close(iter->fd);
+#else
+                c_closedir(iter->dir);
+#endif
+                free(iter);
+        }
+        return NULL;
+}
+
+/**
+ * c_dir_iter_next() - Fetch next directory entry
+ * @iter:               Iterator to operate on
+ * @entryp:             Output argument for the next entry
+ *
+ * Return the next entry of the directory in ``entryp``. The entries ``.``
+ * and ``..`` are skipped. Entries are returned in no particular order. If
+ * the directory is modified during iteration, entries that are added or
+ * removed might or might not be returned.
+ *
+ * Once the end of the directory is reached, ``entryp`` is set to NULL, and
+ * every further call does the same.
+ *
+ * Return: 1 if an entry was returned, 0 at the end of the directory, or a
+ *         negative error code if reading the directory failed.
+ */
+static inline int c_dir_iter_next(CDirIter *iter, const CDirEntry **entryp) {
+#if defined(C_OS_LINUX)
+        CInternalDirent64 *de;
+        long l;
+
+        for (;;) {
+                if (iter->i_buffer >= iter->n_buffer) {
+                        l = syscall(SYS_getdents64, iter->fd, iter->buffer, sizeof(iter->buffer));
+                        if (l < 0)
+                                return -c_errno();
+                        if (l == 0) {
+                                *entryp = NULL;
+                                return 0;
+                        }
+
+                        iter->i_buffer = 0;
+                        iter->n_buffer = (size_t)l;
+                }
+
+                de = (CInternalDirent64 *)((unsigned char *)iter->buffer + iter->i_buffer);
+                iter->i_buffer += de->d_reclen;
+                if (c_internal_dir_is_dot(de->d_name))
+                        continue;
+
+                iter->entry.name = de->d_name;
+                iter->entry.ino = de->d_ino;
+                iter->entry.type = de->d_type;
+                *entryp = &iter->entry;
+                return 1;
+        }
+#else
+        struct dirent *de;
+
+        for (;;) {
+                errno = 0;
+                de = readdir(iter->dir);
+                if (!de) {
+                        if (errno)
+                                return -c_errno();
+                        *entryp = NULL;
+                        return 0;
+                }
+
+                if (c_internal_dir_is_dot(de->d_name))
+                        continue;
+
+                iter->entry.name = de->d_name;
+                iter->entry.ino = (uint64_t)de->d_ino;
+                iter->entry.type = de->d_type;
+                *entryp = &iter->entry;
+                return 1;
+        }
+#endif
+}
+
+/**
+ * c_dir_iter_stat() - Fetch attributes of directory entry
+ * @iter:               Iterator the entry was returned by
+ * @entry:              Entry to query
+ * @st:                 Output argument for the attributes
+ *
+ * Fetch the attributes of ``entry`` via ``fstatat(2)`` relative to the
+ * directory of ``iter``. Symbolic links are not followed. This is an extra
+ * system call per entry, so it should only be used if the file type of the
+ * entry is not sufficient.
+ *
+ * Return: 0 on success, or a negative error code on failure. If the entry
+ *         was removed since it was returned, ``-ENOENT`` is returned.
+ */
+static inline int c_dir_iter_stat(CDirIter *iter, const CDirEntry *entry, struct stat *st) {
+        int r;
+
+        r = fstatat(iter->fd, entry->name, st, AT_SYMLINK_NOFOLLOW);
+        if (r < 0)
+                return -c_errno();
+
+        return 0;
+}
+
 /**
  * DOC: Common Cleanup Helpers
  *
@@ -91,11 +1065,15 @@ static inline DIR *c_closedir(DIR *d) {
  *
  * - ``c_closep()``: Wrapper around :c:func:`c_close()`.
  * - ``c_closedirp()``: Wrapper around :c:func:`c_closedir()`.
+ * - ``c_file_map_freep()``: Wrapper around :c:func:`c_file_map_free()`.
+ * - ``c_dir_iter_freep()``: Wrapper around :c:func:`c_dir_iter_free()`.
  */
 /**/
 
 C_DEFINE_DIRECT_CLEANUP(int, c_close);
 C_DEFINE_CLEANUP(DIR *, c_closedir);
+C_DEFINE_CLEANUP(CFileMap *, c_file_map_free);
+C_DEFINE_CLEANUP(CDirIter *, c_dir_iter_free);
 
 #ifdef __cplusplus
 }
@@ -41,9 +41,11 @@ extern "C" {
 /**/
 
 #include <c-stdaux-generic.h>
+#include <c-stdaux-hash.h>
 
 #if defined(C_COMPILER_GNUC)
 #  include <c-stdaux-gnuc.h>
+#  include <c-stdaux-atomic.h>
 #endif
 
 #if defined(C_OS_LINUX) || defined(C_OS_MACOS)
@@ -19,6 +19,11 @@ static void cleanup_fn(int p) { (void)p; }
 static void direct_cleanup_fn(int p) { (void)p; }
 C_DEFINE_CLEANUP(int, cleanup_fn);
 C_DEFINE_DIRECT_CLEANUP(int, direct_cleanup_fn);
+C_DEFINE_VECTOR(TestVector, int);
+
+static uint64_t test_map_hash(const int *key) { return (uint64_t)*key; }
+static bool test_map_equal(const int *a, const int *b) { return *a == *b; }
+C_DEFINE_HASHMAP(TestMap, int, int, test_map_hash, test_map_equal);
 
 static void test_api_generic(void) {
         /* C_COMPILER_* */
@@ -47,6 +52,11 @@ static void test_api_generic(void) {
 #endif
         }
 
+        /* C_CACHELINE_SIZE */
+        {
+                c_assert(C_CACHELINE_SIZE >= 64);
+        }
+
         /* _c_always_inline_ */
         {
                 c_assert(!always_inline_fn());
@@ -62,6 +72,15 @@ static void test_api_generic(void) {
                 c_assert(_c_likely_(true));
         }
 
+        /* c_prefetch_read, c_prefetch_write */
+        {
+                int v = 0;
+
+                c_prefetch_read(&v, 3);
+                c_prefetch_write(&v, 0);
+                c_assert(!v);
+        }
+
         /* _c_public_ */
         {
                 c_assert(!c_internal_public_fn());
@@ -105,11 +124,28 @@ static void test_api_generic(void) {
                 c_assert(c_assume_aligned(data, 16, 0));
         }
 
+        /* c_assume */
+        {
+                c_assume(true);
+        }
+
         /* c_assert */
         {
                 c_assert(true);
         }
 
+        /* c_assert_always, C_ASSERT_ASSUME */
+        {
+                c_assert_always(true);
+                c_assert(!C_ASSERT_ASSUME);
+        }
+
+        /* c_unreachable */
+        {
+                if (false)
+                        c_unreachable();
+        }
+
         /* c_load */
         {
                 uint64_t data[128] = { 0 };
@@ -117,6 +153,79 @@ static void test_api_generic(void) {
                 c_assert(c_load(uint64_t, le, aligned, data, 0) == 0);
         }
 
+        /* c_{add,sub,mul}_overflow */
+        {
+                size_t v;
+
+                c_assert(!c_add_overflow(1, 1, &v) && v == 2);
+                c_assert(!c_sub_overflow(1, 1, &v) && v == 0);
+                c_assert(!c_mul_overflow(1, 1, &v) && v == 1);
+        }
+
+#if defined(__SIZEOF_INT128__)
+        /* c_load_128*() */
+        {
+                _Alignas(16) uint64_t data[128] = { 0 };
+
+                c_assert(c_load(unsigned __int128, le, aligned, data, 0) == 0);
+                c_assert(c_load_128be_unaligned(data, 1) == 0);
+                c_assert(c_load_128le_unaligned(data, 1) == 0);
+                c_assert(c_load_128be_aligned(data, 0) == 0);
+        }
+#endif
+
+        /* c_store */
+        {
+                uint64_t data[128] = { 0 };
+
+                c_store(uint64_t, le, aligned, data, 0, 0);
+                c_assert(data[0] == 0);
+        }
+
+        /* CCursor, C_CURSOR_INIT, c_cursor_load */
+        {
+                uint64_t data[128] = { 0 };
+                CCursor c = C_CURSOR_INIT(data, sizeof(data));
+
+                c_assert(c_cursor_load(uint64_t, le, &c) == 0);
+        }
+
+        /* C_VARINT_MAX */
+        {
+                uint8_t data[C_VARINT_MAX];
+
+                c_assert(c_varint_encode_u64(data, 0) == 1);
+        }
+
+        /* C_DEFINE_VECTOR */
+        {
+                TestVector v = { 0 };
+
+                c_assert(!TestVector_reserve(&v, 1));
+                c_assert(!TestVector_push(&v, 0));
+                c_assert(!TestVector_insert(&v, 0, 0));
+                c_assert(TestVector_pop(&v) == 0);
+                c_assert(!TestVector_shrink(&v));
+                TestVector_deinit(&v);
+                TestVector_deinitp(&v);
+        }
+
+        /* C_DEFINE_HASHMAP */
+        {
+                TestMap m = { 0 };
+                TestMapEntry *e;
+                size_t iter = 0;
+
+                c_assert(!TestMap_reserve(&m, 1));
+                c_assert(!TestMap_insert(&m, 0, 0));
+                c_assert(TestMap_find(&m, &(int){ 0 }));
+                e = TestMap_next(&m, &iter);
+                c_assert(e && !e->key && !e->value);
+                c_assert(TestMap_remove(&m, &(int){ 0 }, NULL));
+                TestMap_deinit(&m);
+                TestMap_deinitp(&m);
+        }
+
         /* C_DEFINE_CLEANUP / C_DEFINE_DIRECT_CLEANUP */
         {
                 int v = 0;
@@ -145,6 +254,49 @@ static void test_api_generic(void) {
                         (void *)c_load_64be_aligned,
                         (void *)c_load_64le_unaligned,
                         (void *)c_load_64le_aligned,
+                        (void *)c_load_24be_unaligned,
+                        (void *)c_load_24le_unaligned,
+                        (void *)c_load_40be_unaligned,
+                        (void *)c_load_40le_unaligned,
+                        (void *)c_load_48be_unaligned,
+                        (void *)c_load_48le_unaligned,
+                        (void *)c_load_56be_unaligned,
+                        (void *)c_load_56le_unaligned,
+                        (void *)c_load_16be_array,
+                        (void *)c_load_16le_array,
+                        (void *)c_load_32be_array,
+                        (void *)c_load_32le_array,
+                        (void *)c_load_64be_array,
+                        (void *)c_load_64le_array,
+                        (void *)c_store_8,
+                        (void *)c_store_16be_unaligned,
+                        (void *)c_store_16be_aligned,
+                        (void *)c_store_16le_unaligned,
+                        (void *)c_store_16le_aligned,
+                        (void *)c_store_32be_unaligned,
+                        (void *)c_store_32be_aligned,
+                        (void *)c_store_32le_unaligned,
+                        (void *)c_store_32le_aligned,
+                        (void *)c_store_64be_unaligned,
+                        (void *)c_store_64be_aligned,
+                        (void *)c_store_64le_unaligned,
+                        (void *)c_store_64le_aligned,
+                        (void *)c_cursor_init,
+                        (void *)c_cursor_remaining,
+                        (void *)c_cursor_check,
+                        (void *)c_cursor_pull,
+                        (void *)c_cursor_load_8,
+                        (void *)c_cursor_load_16be,
+                        (void *)c_cursor_load_16le,
+                        (void *)c_cursor_load_32be,
+                        (void *)c_cursor_load_32le,
+                        (void *)c_cursor_load_64be,
+                        (void *)c_cursor_load_64le,
+                        (void *)c_varint_decode_u64,
+                        (void *)c_varint_encode_u64,
+                        (void *)c_varint_decode_s64,
+                        (void *)c_varint_encode_s64,
+                        (void *)c_cursor_load_varint,
                         (void *)c_free,
                         (void *)c_fclose,
                         (void *)c_freep,
@@ -166,22 +318,49 @@ static void test_api_generic(void) {
 
 #if defined(C_MODULE_GNUC)
 
+static _c_malloc_ _c_alloc_size_(1) void *alloc_fn(size_t n) { return malloc(n); }
+static _c_cold_ int cold_fn(void) { return 0; }
 static _c_const_ int const_fn(void) { return 0; }
 static _c_deprecated_ _c_unused_ int deprecated_fn(void) { return 0; }
+static _c_flatten_ int flatten_fn(void) { return 0; }
 _c_hidden_ int c_internal_hidden_fn(void);
 _c_hidden_ int c_internal_hidden_fn(void) { return 0; }
+static _c_hot_ int hot_fn(void) { return 0; }
+static _c_noinline_ int noinline_fn(void) { return 0; }
+static _c_nonnull_(1) int nonnull_fn(const int *p) { return *p; }
 static _c_printf_(1, 2) int printf_fn(const _c_unused_ char *f, ...) { return 0; }
 static _c_pure_ int pure_fn(void) { return 0; }
+static _c_returns_nonnull_ const char *returns_nonnull_fn(void) { return ""; }
 static _c_sentinel_ int sentinel_fn(const _c_unused_ char *f, ...) { return 0; }
 static _c_unused_ int unused_fn(void) { return 0; }
 
 static void test_api_gnuc(void) {
+        /* _c_alloc_size_, _c_malloc_ */
+        {
+                void *p = alloc_fn(1);
+
+                c_assert(p);
+                free(p);
+        }
+
+        /* _c_cacheline_aligned_ */
+        {
+                _c_cacheline_aligned_ int v = 0;
+
+                c_assert(!v);
+        }
+
         /* _c_cleanup_ */
         {
                 _c_cleanup_(c_freep) void *foo = NULL;
                 c_assert(!foo);
         }
 
+        /* _c_cold_ */
+        {
+                c_assert(!cold_fn());
+        }
+
         /* _c_const_ */
         {
                 c_assert(!const_fn());
@@ -192,11 +371,33 @@ static void test_api_gnuc(void) {
                 /* see deprecated_fn() */
         }
 
+        /* _c_flatten_ */
+        {
+                c_assert(!flatten_fn());
+        }
+
         /* _c_hidden_ */
         {
                 c_assert(!c_internal_hidden_fn());
         }
 
+        /* _c_hot_ */
+        {
+                c_assert(!hot_fn());
+        }
+
+        /* _c_noinline_ */
+        {
+                c_assert(!noinline_fn());
+        }
+
+        /* _c_nonnull_ */
+        {
+                int v = 0;
+
+                c_assert(!nonnull_fn(&v));
+        }
+
         /* _c_packed_ */
         {
                 struct _c_packed_ FooBar {
@@ -216,6 +417,11 @@ static void test_api_gnuc(void) {
                 c_assert(!pure_fn());
         }
 
+        /* _c_returns_nonnull_ */
+        {
+                c_assert(!*returns_nonnull_fn());
+        }
+
         /* _c_sentinel_ */
         {
                 c_assert(!sentinel_fn("", NULL));
@@ -247,6 +453,13 @@ static void test_api_gnuc(void) {
 #undef MACRO1
         }
 
+        /* C_CACHELINE_PADDED */
+        {
+                C_CACHELINE_PADDED(int) v = {};
+
+                c_assert(!v.value);
+        }
+
         /* C_ARRAY_SIZE */
         {
                 int v[] = { 0, 1, 2 };
@@ -280,6 +493,53 @@ static void test_api_gnuc(void) {
         {
                 c_assert(c_align_to(0, 0) == 0);
         }
+
+        /* c_clz, c_ctz, c_popcount, c_log2, c_is_pow2, c_next_pow2, c_rot{l,r} */
+        {
+                c_assert(c_clz(1u) == sizeof(unsigned int) * CHAR_BIT - 1);
+                c_assert(c_ctz(1u) == 0);
+                c_assert(c_popcount(1u) == 1);
+                c_assert(c_log2(1u) == 0);
+                c_assert(c_is_pow2(1u));
+                c_assert(c_next_pow2(1u) == 1);
+                c_assert(c_rotl(1u, 0) == 1);
+                c_assert(c_rotr(1u, 0) == 1);
+        }
+
+        /* c_add_sat, c_mul_sat */
+        {
+                c_assert(c_add_sat(1u, 1u) == 2);
+                c_assert(c_mul_sat(1u, 1u) == 1);
+        }
+
+        /* CArena, C_ARENA_CHUNK_SIZE, c_arena_* */
+        {
+                _c_cleanup_(c_arena_freep) CArena *arena = NULL;
+                CArenaMark mark;
+                int r;
+
+                r = c_arena_new(&arena, C_ARENA_CHUNK_SIZE);
+                c_assert(!r);
+
+                mark = c_arena_mark(arena);
+                c_assert(c_arena_alloc(arena, 1, 1));
+                c_assert(c_arena_alloc0(arena, 1, 1));
+                c_arena_rewind(arena, mark);
+                c_arena_reset(arena);
+                c_assert(!c_arena_free(NULL));
+        }
+
+        /* CPool, C_POOL_INIT, C_POOL_SLAB_SIZE, c_pool_* */
+        {
+                _c_cleanup_(c_pool_deinitp) CPool pool = C_POOL_INIT(C_POOL_SLAB_SIZE, 1);
+                void *p;
+
+                c_pool_init(&pool, 1, 1);
+                p = c_pool_alloc(&pool);
+                c_assert(p);
+                c_assert(!c_pool_free(&pool, p));
+                c_pool_deinit(&pool);
+        }
 }
 
 #else /* C_MODULE_GNUC */
@@ -289,6 +549,109 @@ static void test_api_gnuc(void) {
 
 #endif /* C_MODULE_GNUC */
 
+#if defined(C_MODULE_HASH)
+
+static void test_api_hash(void) {
+        /* test availability of C symbols */
+        {
+                void *fns[] = {
+                        (void *)c_hash64,
+                        (void *)c_siphash13,
+                        (void *)c_crc32c,
+                };
+                size_t i;
+
+                for (i = 0; i < sizeof(fns) / sizeof(*fns); ++i)
+                        c_assert(!!fns[i]);
+        }
+
+        /* c_hash64, c_siphash13, c_crc32c */
+        {
+                uint8_t key[16] = { 0 };
+
+                c_assert(c_hash64(NULL, 0, 0) == c_hash64(key, 0, 0));
+                c_assert(c_siphash13(NULL, 0, key) == c_siphash13(key, 0, key));
+                c_assert(c_crc32c(0, NULL, 0) == 0);
+        }
+}
+
+#else /* C_MODULE_HASH */
+
+static void test_api_hash(void) {
+}
+
+#endif /* C_MODULE_HASH */
+
+#if defined(C_MODULE_ATOMIC)
+
+static void test_api_atomic(void) {
+        /* C_ATOMIC_* */
+        {
+                int v[] = {
+                        C_ATOMIC_RELAXED,
+                        C_ATOMIC_ACQUIRE,
+                        C_ATOMIC_RELEASE,
+                        C_ATOMIC_ACQ_REL,
+                        C_ATOMIC_SEQ_CST,
+                };
+
+                c_assert(sizeof(v) / sizeof(*v) == 5);
+        }
+
+        /* c_atomic_* */
+        {
+                unsigned int v = 0, e = 0;
+
+                c_atomic_store(&v, 0, C_ATOMIC_RELAXED);
+                c_assert(!c_atomic_load(&v, C_ATOMIC_RELAXED));
+                c_assert(!c_atomic_xchg(&v, 0, C_ATOMIC_RELAXED));
+                c_assert(c_atomic_cmpxchg(&v, &e, 0, C_ATOMIC_RELAXED, C_ATOMIC_RELAXED));
+                c_assert(c_atomic_cmpxchg_weak(&v, &e, 0, C_ATOMIC_RELAXED, C_ATOMIC_RELAXED) || true);
+                c_assert(!c_atomic_fetch_add(&v, 0, C_ATOMIC_RELAXED));
+                c_assert(!c_atomic_fetch_sub(&v, 0, C_ATOMIC_RELAXED));
+                c_assert(!c_atomic_fetch_and(&v, 0, C_ATOMIC_RELAXED));
+                c_assert(!c_atomic_fetch_or(&v, 0, C_ATOMIC_RELAXED));
+                c_assert(!c_atomic_fetch_xor(&v, 0, C_ATOMIC_RELAXED));
+                c_atomic_fence(C_ATOMIC_SEQ_CST);
+        }
+
+        /* CSpscRing, c_spsc_ring_* */
+        {
+                _c_cleanup_(c_spsc_ring_freep) CSpscRing *ring = NULL;
+                void *p = NULL;
+                int r;
+
+                r = c_spsc_ring_new(&ring, 1);
+                c_assert(!r);
+                c_assert(c_spsc_ring_push(ring, NULL));
+                c_assert(c_spsc_ring_pop(ring, &p));
+                c_assert(!c_spsc_ring_push_n(ring, &p, 0));
+                c_assert(!c_spsc_ring_pop_n(ring, &p, 1));
+                c_assert(!c_spsc_ring_free(NULL));
+        }
+
+        /* CMpmcQueue, c_mpmc_queue_* */
+        {
+                _c_cleanup_(c_mpmc_queue_freep) CMpmcQueue *queue = NULL;
+                void *p = NULL;
+                int r;
+
+                r = c_mpmc_queue_new(&queue, 1);
+                c_assert(!r);
+                c_assert(c_mpmc_queue_push(queue, NULL));
+                c_assert(c_mpmc_queue_pop(queue, &p));
+                c_assert(!c_mpmc_queue_pop(queue, &p));
+                c_assert(!c_mpmc_queue_free(NULL));
+        }
+}
+
+#else /* C_MODULE_ATOMIC */
+
+static void test_api_atomic(void) {
+}
+
+#endif /* C_MODULE_ATOMIC */
+
 #if defined(C_MODULE_UNIX)
 
 static void test_api_unix(void) {
@@ -299,12 +662,40 @@ static void test_api_unix(void) {
                         (void *)c_closedir,
                         (void *)c_closep,
                         (void *)c_closedirp,
+                        (void *)c_read_full,
+                        (void *)c_write_full,
+                        (void *)c_readv_full,
+                        (void *)c_writev_full,
+                        (void *)c_file_map_new,
+                        (void *)c_file_map_free,
+                        (void *)c_file_map_freep,
+                        (void *)c_copy_fd,
+                        (void *)c_close_range,
+                        (void *)c_closefrom,
+                        (void *)c_dir_iter_new,
+                        (void *)c_dir_iter_free,
+                        (void *)c_dir_iter_freep,
+                        (void *)c_dir_iter_next,
+                        (void *)c_dir_iter_stat,
                 };
                 size_t i;
 
                 for (i = 0; i < sizeof(fns) / sizeof(*fns); ++i)
                         c_assert(!!fns[i]);
         }
+
+        /* C_FILE_MAP_* */
+        {
+                unsigned int v[] = {
+                        C_FILE_MAP_WRITABLE,
+                        C_FILE_MAP_SEQUENTIAL,
+                        C_FILE_MAP_RANDOM,
+                        C_FILE_MAP_WILLNEED,
+                        C_FILE_MAP_POPULATE,
+                };
+
+                c_assert(sizeof(v) / sizeof(*v) == 5);
+        }
 }
 
 #else /* C_MODULE_UNIX */
@@ -317,6 +708,8 @@ static void test_api_unix(void) {
 int main(void) {
         test_api_generic();
         test_api_gnuc();
+        test_api_hash();
+        test_api_atomic();
         test_api_unix();
         return 0;
 }
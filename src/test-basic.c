@@ -9,8 +9,34 @@
 #include <stdlib.h>
 #include "c-stdaux.h"
 
+#if defined(C_MODULE_UNIX)
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
 #if defined(C_MODULE_GENERIC)
 
+C_DEFINE_VECTOR(TestVector, uint32_t);
+typedef struct { char v[SIZE_MAX / 4]; } TestBigElement;
+C_DEFINE_VECTOR(TestBigVector, TestBigElement);
+
+static uint64_t test_map_hash(const uint64_t *key) {
+        return *key * UINT64_C(0x9e3779b97f4a7c15);
+}
+
+/* only 3 bits of entropy, to force long probe sequences */
+static uint64_t test_map_hash_bad(const uint64_t *key) {
+        return (*key % 8) * UINT64_C(0x2000000000000003);
+}
+
+static bool test_map_equal(const uint64_t *a, const uint64_t *b) {
+        return *a == *b;
+}
+
+C_DEFINE_HASHMAP(TestMap, uint64_t, uint64_t, test_map_hash, test_map_equal);
+C_DEFINE_HASHMAP(TestBadMap, uint64_t, uint64_t, test_map_hash_bad, test_map_equal);
+
 static int check_cassert_unreachable(int switch_val) {
     int result;
 
@@ -25,6 +51,36 @@ static int check_cassert_unreachable(int switch_val) {
     return result;
 }
 
+static int check_unreachable(int switch_val) {
+        /* must not trigger a "-Wreturn-type" warning */
+        switch (switch_val) {
+        case 1:
+                return 1;
+        case 2:
+                return 2;
+        default:
+                c_unreachable();
+        }
+}
+
+/*
+ * With C_ASSERT_ASSUME, c_assert() must keep working as a plain assertion
+ * as long as NDEBUG is unset.
+ */
+#undef C_ASSERT_ASSUME
+#define C_ASSERT_ASSUME 1
+static int check_assert_assume(unsigned int v) {
+        c_assert(v < 4);
+        return (int)(v % 4);
+}
+#undef C_ASSERT_ASSUME
+#define C_ASSERT_ASSUME 0
+
+static int check_assume(unsigned int v) {
+        c_assume(v < 4);
+        return (int)(v % 4);
+}
+
 static void test_basic_generic(int non_constant_expr) {
         /*
          * Verify `_c_boolean_expr_` evaluates expressions to a boolean value
@@ -62,6 +118,24 @@ static void test_basic_generic(int non_constant_expr) {
 #endif
         }
 
+        /*
+         * Test the cache-line size to be a power of 2, and verify that the
+         * prefetch helpers evaluate their address exactly once (even where
+         * they are no-ops) and accept invalid addresses.
+         */
+        {
+                int v[2] = { 0, 0 }, *p = v;
+
+                c_assert(C_CACHELINE_SIZE >= 64);
+                c_assert(!(C_CACHELINE_SIZE & (C_CACHELINE_SIZE - 1)));
+
+                c_prefetch_read(p++, 0);
+                c_prefetch_write(p++, 3);
+                c_assert(p == v + 2);
+                c_prefetch_read(NULL, 1);
+                c_prefetch_write((int *)(uintptr_t)-1, 2);
+        }
+
         /*
          * Test stringify/concatenation helpers. Also make sure to test that
          * the passed arguments are evaluated first, before they're stringified
@@ -244,6 +318,59 @@ static void test_basic_generic(int non_constant_expr) {
                 c_assert(check_cassert_unreachable(2) == 2);
         }
 
+        /*
+         * Test c_assert_always(). Side-effects must be evaluated exactly once,
+         * and a failed assertion must abort, which is verified in a child
+         * process where available.
+         */
+        {
+                int v = 0;
+
+                c_assert_always(!v);
+                c_assert_always(++v);
+                c_assert(v == 1);
+
+#if defined(C_MODULE_UNIX)
+                {
+                        int r, status;
+                        pid_t pid;
+
+                        pid = fork();
+                        c_assert(pid >= 0);
+                        if (pid == 0) {
+                                /* silence the assertion message */
+                                close(STDERR_FILENO);
+                                c_assert_always(non_constant_expr < 0);
+                                _exit(0);
+                        }
+
+                        r = waitpid(pid, &status, 0);
+                        c_assert(r == pid);
+                        c_assert(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+                }
+#endif
+        }
+
+        /*
+         * Test c_assume() and c_unreachable(). As hints, they cannot change
+         * the result of valid code, so simply verify they compile in all
+         * contexts and keep the results intact.
+         */
+        {
+                unsigned int i;
+
+                c_assert(check_unreachable(1) == 1);
+                c_assert(check_unreachable(2) == 2);
+
+                for (i = 0; i < 4; ++i) {
+                        c_assert(check_assume(i) == (int)i);
+                        c_assert(check_assert_assume(i) == (int)i);
+                }
+
+                c_assume(non_constant_expr > 0);
+                c_assert(non_constant_expr > 0);
+        }
+
         /*
          * Test c_errno(). Simply verify that the correct value is returned. It
          * must always be >0 and equivalent to `errno' if set.
@@ -322,6 +449,188 @@ static void test_basic_generic(int non_constant_expr) {
                 c_assert(c_memcmp(&v1, &v2, 8) != 0);
         }
 
+        /*
+         * Test the checked arithmetic helpers. Verify the result type decides
+         * about overflows, and wrapped results are stored on overflow.
+         */
+        {
+                unsigned long long ull;
+                unsigned int u;
+                uint8_t u8;
+                size_t sz;
+                int8_t i8;
+                int i;
+
+                c_assert(!c_add_overflow(100, 27, &i8) && i8 == 127);
+                c_assert(c_add_overflow(100, 28, &i8) && i8 == -128);
+                c_assert(!c_add_overflow(-100, -28, &i8) && i8 == -128);
+                c_assert(c_add_overflow(-100, -29, &i8) && i8 == 127);
+                c_assert(!c_add_overflow(200, 55, &u8) && u8 == 255);
+                c_assert(c_add_overflow(200, 56, &u8) && u8 == 0);
+                c_assert(!c_add_overflow(INT_MAX, INT_MIN, &i) && i == -1);
+                c_assert(c_add_overflow(INT_MAX, 1, &i) && i == INT_MIN);
+                c_assert(c_add_overflow(UINT_MAX, 1u, &u) && u == 0);
+                c_assert(c_add_overflow(ULLONG_MAX, 1ull, &ull) && ull == 0);
+
+                c_assert(!c_sub_overflow(0, 0, &u) && u == 0);
+                c_assert(c_sub_overflow(0u, 1u, &u) && u == UINT_MAX);
+                c_assert(!c_sub_overflow(-100, 28, &i8) && i8 == -128);
+                c_assert(c_sub_overflow(-100, 29, &i8) && i8 == 127);
+                c_assert(c_sub_overflow(100, -28, &i8) && i8 == -128);
+                c_assert(!c_sub_overflow(INT_MIN, INT_MIN, &i) && i == 0);
+                c_assert(c_sub_overflow(0, INT_MIN, &i) && i == INT_MIN);
+
+                c_assert(!c_mul_overflow(0, 0, &u8) && u8 == 0);
+                c_assert(!c_mul_overflow(15, 17, &u8) && u8 == 255);
+                c_assert(c_mul_overflow(16, 16, &u8) && u8 == 0);
+                c_assert(!c_mul_overflow(-16, 8, &i8) && i8 == -128);
+                c_assert(c_mul_overflow(16, 8, &i8) && i8 == -128);
+                c_assert(c_mul_overflow(-1, INT_MIN, &i) && i == INT_MIN);
+                c_assert(!c_mul_overflow(-1, -INT_MAX, &i) && i == INT_MAX);
+                c_assert(!c_mul_overflow(SIZE_MAX / 2, (size_t)2, &sz) && sz == SIZE_MAX - 1);
+                c_assert(c_mul_overflow(SIZE_MAX / 2 + 1, (size_t)2, &sz) && sz == 0);
+        }
+
+        /*
+         * Test C_DEFINE_VECTOR() by growing a vector via all its operations
+         * and verifying its content. Overflows of the capacity calculation
+         * must be caught without modifying the vector.
+         */
+        {
+                TestVector v = { 0 };
+                TestBigVector big = { 0 };
+                uint32_t i;
+                int r;
+
+                for (i = 0; i < 1000; ++i) {
+                        r = TestVector_push(&v, i * 2);
+                        c_assert(!r);
+                        c_assert(v.n == i + 1);
+                        c_assert(v.capacity >= v.n);
+                }
+                for (i = 0; i < 1000; ++i) {
+                        r = TestVector_insert(&v, i * 2 + 1, i * 2 + 1);
+                        c_assert(!r);
+                }
+                r = TestVector_insert(&v, 0, UINT32_MAX);
+                c_assert(!r);
+                c_assert(v.n == 2001);
+                c_assert(v.data[0] == UINT32_MAX);
+                for (i = 1; i < v.n; ++i)
+                        c_assert(v.data[i] == i - 1);
+
+                c_assert(TestVector_pop(&v) == 1999);
+                c_assert(TestVector_pop(&v) == 1998);
+                c_assert(v.n == 1999);
+
+                r = TestVector_shrink(&v);
+                c_assert(!r);
+                c_assert(v.capacity == 1999);
+                r = TestVector_reserve(&v, 100);
+                c_assert(!r);
+                c_assert(v.capacity == 1999);
+                r = TestVector_reserve(&v, 4096);
+                c_assert(!r);
+                c_assert(v.capacity == 4096);
+                r = TestVector_reserve(&v, SIZE_MAX / 2);
+                c_assert(r == -ENOMEM);
+                c_assert(v.capacity == 4096 && v.n == 1999);
+
+                while (v.n)
+                        (void)TestVector_pop(&v);
+                r = TestVector_shrink(&v);
+                c_assert(!r);
+                c_assert(!v.data && !v.capacity);
+
+                r = TestVector_insert(&v, 0, 7);
+                c_assert(!r);
+                c_assert(v.n == 1 && v.data[0] == 7);
+                c_assert(v.capacity * sizeof(uint32_t) >= 64);
+
+                TestVector_deinit(&v);
+                c_assert(!v.data && !v.n && !v.capacity);
+
+                big.capacity = 4;
+                r = TestBigVector_reserve(&big, 5);
+                c_assert(r == -ENOMEM);
+                c_assert(!big.data && big.capacity == 4);
+        }
+
+        /*
+         * Test C_DEFINE_HASHMAP() by inserting, looking up, and removing keys
+         * in a pseudo-random order, and comparing against a reference. Use
+         * a good and a bad hash function, so both short and long probe
+         * sequences, as well as wrap-arounds, are covered.
+         */
+        {
+                uint64_t key, value, state = 1;
+                bool present[512] = { 0 };
+                TestBadMap bad = { 0 };
+                TestMap m = { 0 };
+                TestMapEntry *e;
+                size_t i, n = 0, iter;
+                int r;
+
+                c_assert(!TestMap_find(&m, &(uint64_t){ 0 }));
+                c_assert(!TestMap_remove(&m, &(uint64_t){ 0 }, NULL));
+                iter = 0;
+                c_assert(!TestMap_next(&m, &iter));
+
+                for (i = 0; i < 100000; ++i) {
+                        state = state * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+                        key = (state >> 33) % 512;
+
+                        if ((state >> 20) % 3) {
+                                r = TestMap_insert(&m, key, key * 3);
+                                c_assert(r == (present[key] ? -EEXIST : 0));
+                                r = TestBadMap_insert(&bad, key, key * 3);
+                                c_assert(r == (present[key] ? -EEXIST : 0));
+                                n += !present[key];
+                                present[key] = true;
+                        } else {
+                                value = 0;
+                                c_assert(TestMap_remove(&m, &key, &value) == present[key]);
+                                c_assert(value == (present[key] ? key * 3 : 0));
+                                c_assert(TestBadMap_remove(&bad, &key, NULL) == present[key]);
+                                n -= present[key];
+                                present[key] = false;
+                        }
+
+                        c_assert(m.n == n && bad.n == n);
+                        c_assert(m.n <= m.mask + 1 - (m.mask + 1) / 8);
+
+                        if (i % 1024)
+                                continue;
+
+                        for (key = 0; key < 512; ++key) {
+                                c_assert(!TestMap_find(&m, &key) == !present[key]);
+                                c_assert(!TestBadMap_find(&bad, &key) == !present[key]);
+                                if (present[key]) {
+                                        c_assert(*TestMap_find(&m, &key) == key * 3);
+                                        c_assert(*TestBadMap_find(&bad, &key) == key * 3);
+                                }
+                        }
+
+                        iter = 0;
+                        for (key = 0; (e = TestMap_next(&m, &iter)); ++key)
+                                c_assert(present[e->key] && e->value == e->key * 3);
+                        c_assert(key == n);
+                }
+
+                r = TestMap_reserve(&m, 4096);
+                c_assert(!r);
+                c_assert(m.mask + 1 == 8192);
+                for (key = 0; key < 512; ++key)
+                        c_assert(!TestMap_find(&m, &key) == !present[key]);
+                r = TestMap_reserve(&m, SIZE_MAX);
+                c_assert(r == -ENOMEM);
+                c_assert(m.mask + 1 == 8192 && m.n == n);
+
+                TestMap_deinit(&m);
+                TestBadMap_deinit(&bad);
+                c_assert(!m.entries && !m.ctrl && !m.n);
+        }
+
         /*
          * Test c_load*() and its mapping to c_load_*() functions.
          */
@@ -348,6 +657,272 @@ static void test_basic_generic(int non_constant_expr) {
                 c_assert(c_load(uint64_t, le, unaligned, data, 7) == UINT64_C(0x0706050403020100));
                 c_assert(c_load(uint64_t, le, aligned, data, 8) == UINT64_C(0x0807060504030201));
         }
+
+        /*
+         * Test the odd-sized c_load_*() helpers, as well as the 128-bit
+         * helpers and their mapping in c_load(), if supported.
+         */
+        {
+                _Alignas(16) uint8_t data[32] = {
+                        0, 0, 0, 0, 0, 0, 0, 0,
+                        0, 0, 0, 0, 0, 0, 0, 0,
+                        1, 2, 3, 4, 5, 6, 7, 8,
+                        9, 10, 11, 12, 13, 14, 15, 16,
+                };
+
+                c_assert(c_load_24be_unaligned(data, 15) == UINT32_C(0x000102));
+                c_assert(c_load_24le_unaligned(data, 15) == UINT32_C(0x020100));
+                c_assert(c_load_40be_unaligned(data, 15) == UINT64_C(0x0001020304));
+                c_assert(c_load_40le_unaligned(data, 15) == UINT64_C(0x0403020100));
+                c_assert(c_load_48be_unaligned(data, 15) == UINT64_C(0x000102030405));
+                c_assert(c_load_48le_unaligned(data, 15) == UINT64_C(0x050403020100));
+                c_assert(c_load_56be_unaligned(data, 15) == UINT64_C(0x00010203040506));
+                c_assert(c_load_56le_unaligned(data, 15) == UINT64_C(0x06050403020100));
+
+#if defined(__SIZEOF_INT128__)
+                {
+                        unsigned __int128 v;
+
+                        v = c_load(unsigned __int128, be, aligned, data, 16);
+                        c_assert((uint64_t)(v >> 64) == UINT64_C(0x0102030405060708));
+                        c_assert((uint64_t)v == UINT64_C(0x090a0b0c0d0e0f10));
+                        v = c_load(unsigned __int128, le, aligned, data, 16);
+                        c_assert((uint64_t)(v >> 64) == UINT64_C(0x100f0e0d0c0b0a09));
+                        c_assert((uint64_t)v == UINT64_C(0x0807060504030201));
+                        v = c_load(unsigned __int128, be, unaligned, data, 15);
+                        c_assert((uint64_t)(v >> 64) == UINT64_C(0x0001020304050607));
+                        c_assert((uint64_t)v == UINT64_C(0x08090a0b0c0d0e0f));
+                        v = c_load(unsigned __int128, le, unaligned, data, 15);
+                        c_assert((uint64_t)(v >> 64) == UINT64_C(0x0f0e0d0c0b0a0908));
+                        c_assert((uint64_t)v == UINT64_C(0x0706050403020100));
+                }
+#endif
+        }
+
+        /*
+         * Test c_load_*_array() against the scalar c_load_*() helpers. Use
+         * odd lengths and offsets to exercise any vectorized main loop as
+         * well as its scalar tail. Also verify in-place conversion.
+         */
+        {
+                uint8_t data[1024 + 1];
+                uint16_t v16[512];
+                uint32_t v32[256];
+                uint64_t v64[128];
+                size_t i, n;
+
+                for (i = 0; i < sizeof(data); ++i)
+                        data[i] = (uint8_t)(i * 7 + 3);
+
+                c_load_16be_array(NULL, NULL, 0);
+                c_load_64le_array(NULL, NULL, 0);
+
+                for (n = 0; n <= 128; n = n * 2 + 1) {
+                        c_load_16be_array(v16, data + 1, n * 4);
+                        for (i = 0; i < n * 4; ++i)
+                                c_assert(v16[i] == c_load_16be_unaligned(data + 1, i * 2));
+                        c_load_16le_array(v16, data + 1, n * 4);
+                        for (i = 0; i < n * 4; ++i)
+                                c_assert(v16[i] == c_load_16le_unaligned(data + 1, i * 2));
+
+                        c_load_32be_array(v32, data + 1, n * 2);
+                        for (i = 0; i < n * 2; ++i)
+                                c_assert(v32[i] == c_load_32be_unaligned(data + 1, i * 4));
+                        c_load_32le_array(v32, data + 1, n * 2);
+                        for (i = 0; i < n * 2; ++i)
+                                c_assert(v32[i] == c_load_32le_unaligned(data + 1, i * 4));
+
+                        c_load_64be_array(v64, data + 1, n);
+                        for (i = 0; i < n; ++i)
+                                c_assert(v64[i] == c_load_64be_unaligned(data + 1, i * 8));
+                        c_load_64le_array(v64, data + 1, n);
+                        for (i = 0; i < n; ++i)
+                                c_assert(v64[i] == c_load_64le_unaligned(data + 1, i * 8));
+                }
+
+                c_memcpy(v32, data, sizeof(v32));
+                c_load_32be_array(v32, v32, sizeof(v32) / sizeof(*v32));
+                for (i = 0; i < sizeof(v32) / sizeof(*v32); ++i)
+                        c_assert(v32[i] == c_load_32be_unaligned(data, i * 4));
+        }
+
+        /*
+         * Test c_store*() and its mapping to c_store_*() functions. Verify
+         * the written bytes directly, as well as the round-trip through the
+         * matching c_load_*() functions.
+         */
+        {
+                _Alignas(8) uint8_t data[16] = { 0 };
+                const uint8_t be[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+                const uint8_t le[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+
+                c_store_8(data, 7, 0xff);
+                c_assert(data[7] == 0xff);
+                c_assert(data[6] == 0 && data[8] == 0);
+
+                c_memzero(data, sizeof(data));
+                c_store(uint16_t, be, unaligned, data, 7, UINT16_C(0x0102));
+                c_assert(!memcmp(data + 7, be, 2));
+                c_store(uint16_t, be, aligned, data, 8, UINT16_C(0x0102));
+                c_assert(!memcmp(data + 8, be, 2));
+                c_store(uint16_t, le, unaligned, data, 7, UINT16_C(0x0708));
+                c_assert(!memcmp(data + 7, le, 2));
+                c_store(uint16_t, le, aligned, data, 8, UINT16_C(0x0708));
+                c_assert(!memcmp(data + 8, le, 2));
+
+                c_memzero(data, sizeof(data));
+                c_store(uint32_t, be, unaligned, data, 7, UINT32_C(0x01020304));
+                c_assert(!memcmp(data + 7, be, 4));
+                c_store(uint32_t, be, aligned, data, 8, UINT32_C(0x01020304));
+                c_assert(!memcmp(data + 8, be, 4));
+                c_store(uint32_t, le, unaligned, data, 7, UINT32_C(0x05060708));
+                c_assert(!memcmp(data + 7, le, 4));
+                c_store(uint32_t, le, aligned, data, 8, UINT32_C(0x05060708));
+                c_assert(!memcmp(data + 8, le, 4));
+
+                c_memzero(data, sizeof(data));
+                c_store(uint64_t, be, unaligned, data, 7, UINT64_C(0x0102030405060708));
+                c_assert(!memcmp(data + 7, be, 8));
+                c_store(uint64_t, be, aligned, data, 8, UINT64_C(0x0102030405060708));
+                c_assert(!memcmp(data + 8, be, 8));
+                c_store(uint64_t, le, unaligned, data, 7, UINT64_C(0x0102030405060708));
+                c_assert(!memcmp(data + 7, le, 8));
+                c_store(uint64_t, le, aligned, data, 8, UINT64_C(0x0102030405060708));
+                c_assert(!memcmp(data + 8, le, 8));
+
+                c_store(uint16_t, be, unaligned, data, 3, UINT16_C(0xa1b2));
+                c_assert(c_load(uint16_t, be, unaligned, data, 3) == UINT16_C(0xa1b2));
+                c_store(uint32_t, le, unaligned, data, 3, UINT32_C(0xa1b2c3d4));
+                c_assert(c_load(uint32_t, le, unaligned, data, 3) == UINT32_C(0xa1b2c3d4));
+                c_store(uint64_t, be, unaligned, data, 3, UINT64_C(0xa1b2c3d4e5f60718));
+                c_assert(c_load(uint64_t, be, unaligned, data, 3) == UINT64_C(0xa1b2c3d4e5f60718));
+        }
+
+        /*
+         * Test CCursor. Parse a simple message with a single up-front length
+         * check, and verify that slices point into the original buffer.
+         */
+        {
+                const uint8_t data[] = {
+                        0x01,
+                        0x01, 0x02,
+                        0x02, 0x01,
+                        0x01, 0x02, 0x03, 0x04,
+                        0x04, 0x03, 0x02, 0x01,
+                        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                        0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+                        0xaa, 0xbb,
+                };
+                CCursor c = C_CURSOR_INIT(data, sizeof(data));
+                const uint8_t *slice;
+
+                c_assert(c_cursor_remaining(&c) == sizeof(data));
+                c_assert(c_cursor_check(&c, sizeof(data)));
+                c_assert(!c_cursor_check(&c, sizeof(data) + 1));
+                c_assert(!c_cursor_check(&c, SIZE_MAX));
+
+                c_assert(c_cursor_load_8(&c) == 0x01);
+                c_assert(c_cursor_load_16be(&c) == UINT16_C(0x0102));
+                c_assert(c_cursor_load_16le(&c) == UINT16_C(0x0102));
+                c_assert(c_cursor_load(uint32_t, be, &c) == UINT32_C(0x01020304));
+                c_assert(c_cursor_load(uint32_t, le, &c) == UINT32_C(0x01020304));
+                c_assert(c_cursor_load(uint64_t, be, &c) == UINT64_C(0x0102030405060708));
+                c_assert(c_cursor_load(uint64_t, le, &c) == UINT64_C(0x0102030405060708));
+
+                c_assert(c_cursor_remaining(&c) == 2);
+                c_assert(!c_cursor_check(&c, 3));
+                slice = c_cursor_pull(&c, 2);
+                c_assert(slice == data + sizeof(data) - 2);
+                c_assert(slice[0] == 0xaa && slice[1] == 0xbb);
+                c_assert(c_cursor_remaining(&c) == 0);
+                c_assert(c_cursor_check(&c, 0));
+                c_assert(!c_cursor_check(&c, 1));
+
+                c_cursor_init(&c, NULL, 0);
+                c_assert(c_cursor_remaining(&c) == 0);
+                c_assert(c_cursor_check(&c, 0));
+        }
+
+        /*
+         * Test varint encoding and decoding. Verify some well-known
+         * encodings, then round-trip values of all lengths through both the
+         * byte-wise and the word-wise decoder (which is only used if enough
+         * memory is available). Finally, verify truncated and overflowing
+         * encodings are rejected.
+         */
+        {
+                const uint8_t max[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 };
+                uint8_t buf[C_VARINT_MAX + 8];
+                uint64_t u, values[4];
+                int64_t i64;
+                size_t i, j, n;
+                CCursor c;
+
+                c_assert(c_varint_encode_u64(buf, 0) == 1 && buf[0] == 0x00);
+                c_assert(c_varint_encode_u64(buf, 127) == 1 && buf[0] == 0x7f);
+                c_assert(c_varint_encode_u64(buf, 128) == 2 && buf[0] == 0x80 && buf[1] == 0x01);
+                c_assert(c_varint_encode_u64(buf, 300) == 2 && buf[0] == 0xac && buf[1] == 0x02);
+                c_assert(c_varint_encode_u64(buf, UINT64_MAX) == sizeof(max));
+                c_assert(!memcmp(buf, max, sizeof(max)));
+                c_assert(c_varint_decode_u64(max, sizeof(max), &u) == sizeof(max));
+                c_assert(u == UINT64_MAX);
+
+                for (i = 0; i < 64; ++i) {
+                        values[0] = UINT64_C(1) << i;
+                        values[1] = values[0] - 1;
+                        values[2] = values[0] | 1;
+                        values[3] = ~values[1];
+
+                        for (j = 0; j < sizeof(values) / sizeof(*values); ++j) {
+                                c_memset(buf, 0xff, sizeof(buf));
+                                n = c_varint_encode_u64(buf, values[j]);
+                                c_assert(n >= 1 && n <= C_VARINT_MAX);
+
+                                u = 0;
+                                c_assert(c_varint_decode_u64(buf, n, &u) == n);
+                                c_assert(u == values[j]);
+                                u = 0;
+                                c_assert(c_varint_decode_u64(buf, sizeof(buf), &u) == n);
+                                c_assert(u == values[j]);
+                                c_assert(c_varint_decode_u64(buf, n - 1, &u) == 0);
+
+                                i64 = (int64_t)values[j];
+                                n = c_varint_encode_s64(buf, i64);
+                                i64 = 0;
+                                c_assert(c_varint_decode_s64(buf, sizeof(buf), &i64) == n);
+                                c_assert(i64 == (int64_t)values[j]);
+                        }
+                }
+
+                c_assert(c_varint_encode_s64(buf, 0) == 1 && buf[0] == 0);
+                c_assert(c_varint_encode_s64(buf, -1) == 1 && buf[0] == 1);
+                c_assert(c_varint_encode_s64(buf, 1) == 1 && buf[0] == 2);
+                c_assert(c_varint_encode_s64(buf, -64) == 1 && buf[0] == 0x7f);
+                c_assert(c_varint_encode_s64(buf, INT64_MIN) == C_VARINT_MAX);
+                c_assert(c_varint_decode_u64(buf, sizeof(buf), &u) == C_VARINT_MAX);
+                c_assert(u == UINT64_MAX);
+
+                c_assert(c_varint_decode_u64(NULL, 0, &u) == 0);
+
+                c_memcpy(buf, max, sizeof(max));
+                buf[9] = 0x02;
+                c_assert(c_varint_decode_u64(buf, sizeof(buf), &u) == 0);
+                c_assert(c_varint_decode_u64(buf, sizeof(max), &u) == 0);
+                buf[9] = 0x81;
+                buf[10] = 0x00;
+                c_assert(c_varint_decode_u64(buf, sizeof(buf), &u) == 0);
+                c_assert(c_varint_decode_u64(buf, 11, &u) == 0);
+
+                buf[0] = 0xac;
+                buf[1] = 0x02;
+                buf[2] = 0x80;
+                c_cursor_init(&c, buf, 3);
+                c_assert(c_cursor_load_varint(&c, &u));
+                c_assert(u == 300);
+                c_assert(c_cursor_remaining(&c) == 1);
+                c_assert(!c_cursor_load_varint(&c, &u));
+                c_assert(c_cursor_remaining(&c) == 1);
+        }
 }
 
 #else /* C_MODULE_GENERIC */
@@ -371,6 +946,27 @@ static void test_basic_gnuc(int non_constant_expr) {
                 c_assert(v == 1);
         }
 
+        /*
+         * Test cache-line alignment and padding. Array elements of padded
+         * types must never share a cache line, regardless of their size.
+         */
+        {
+                typedef C_CACHELINE_PADDED(uint8_t) TestSmall;
+                typedef C_CACHELINE_PADDED(struct { char v[C_CACHELINE_SIZE + 1]; }) TestLarge;
+                struct {
+                        char a;
+                        _c_cacheline_aligned_ char b;
+                } s;
+                TestSmall small[2];
+
+                static_assert(alignof(TestSmall) == C_CACHELINE_SIZE, "");
+                static_assert(sizeof(TestSmall) == C_CACHELINE_SIZE, "");
+                static_assert(sizeof(TestLarge) == 2 * C_CACHELINE_SIZE, "");
+                static_assert(offsetof(__typeof__(s), b) == C_CACHELINE_SIZE, "");
+                c_assert(!((uintptr_t)&small[1].value % C_CACHELINE_SIZE));
+                c_assert((char *)&small[1] - (char *)&small[0] == C_CACHELINE_SIZE);
+        }
+
         /*
          * Test array-size helper. This simply computes the number of elements
          * of an array, instead of the binary size.
@@ -549,6 +1145,253 @@ static void test_basic_gnuc(int non_constant_expr) {
                 c_assert(__builtin_constant_p(c_align_to(16, 7 + 1)));
                 c_assert(c_align_to(15, non_constant_expr ? 8 : 16) == 16);
         }
+
+        /*
+         * Saturating arithmetic: Verify results saturate at the maximum of the
+         * promoted type, arguments are evaluated once, and constant arguments
+         * yield constant results.
+         */
+        {
+                unsigned int x = 0, y = 2;
+
+                c_assert(c_add_sat(0u, 0u) == 0);
+                c_assert(c_add_sat(UINT32_C(0xfffffffe), UINT32_C(1)) == UINT32_C(0xffffffff));
+                c_assert(c_add_sat(UINT32_C(0xfffffffe), UINT32_C(2)) == UINT32_C(0xffffffff));
+                c_assert(c_add_sat(UINT32_C(0xffffffff), UINT64_C(1)) == UINT64_C(0x100000000));
+                c_assert(c_add_sat(UINT64_MAX, UINT64_MAX) == UINT64_MAX);
+                c_assert(c_add_sat((uint8_t)255, (uint8_t)1) == 256);
+                c_assert(c_add_sat(SIZE_MAX - (size_t)non_constant_expr, (size_t)2) == SIZE_MAX);
+
+                c_assert(c_mul_sat(0u, UINT_MAX) == 0);
+                c_assert(c_mul_sat(UINT_MAX, 1u) == UINT_MAX);
+                c_assert(c_mul_sat(UINT_MAX, 2u) == UINT_MAX);
+                c_assert(c_mul_sat(UINT32_C(0x10000), UINT32_C(0x10000)) == UINT32_C(0xffffffff));
+                c_assert(c_mul_sat(UINT32_C(0x10000), UINT64_C(0x10000)) == UINT64_C(0x100000000));
+                c_assert(c_mul_sat((uint16_t)0xffff, (uint16_t)0xffff) == UINT32_C(0xfffe0001));
+                c_assert(c_mul_sat(SIZE_MAX / 2 + (size_t)non_constant_expr, (size_t)2) == SIZE_MAX);
+                c_assert(c_mul_sat(SIZE_MAX / 2 + (size_t)!non_constant_expr, (size_t)2) == SIZE_MAX - 1);
+
+                c_assert(__builtin_constant_p(c_add_sat(UINT_MAX, 1u)));
+                c_assert(__builtin_constant_p(c_mul_sat(UINT_MAX, 2u)));
+                c_assert(!__builtin_constant_p(c_add_sat(1u, (unsigned int)non_constant_expr)));
+                c_assert(!__builtin_constant_p(c_mul_sat(2u, (unsigned int)non_constant_expr)));
+
+                c_assert(c_add_sat(x++, x++) == 1);
+                c_assert(c_mul_sat(x++, y++) == 4);
+                c_assert(x == 3 && y == 3);
+        }
+
+        /*
+         * Memory arenas: Verify allocations are aligned and do not overlap,
+         * oversized allocations are served, and marks, rewinds, and resets
+         * restore the exact allocation position.
+         */
+        {
+                _c_cleanup_(c_arena_freep) CArena *arena = NULL;
+                CArenaMark mark;
+                uint8_t *p, *q, *list[256];
+                size_t i, j;
+                int r;
+
+                r = c_arena_new(&arena, 1024);
+                c_assert(!r);
+                c_assert(arena->chunk_size == 1024);
+                c_assert(!arena->chunk);
+
+                for (i = 0; i < C_ARRAY_SIZE(list); ++i) {
+                        j = (size_t)1 << (i % 7);
+                        list[i] = c_arena_alloc(arena, i, j);
+                        c_assert(list[i]);
+                        c_assert(!((uintptr_t)list[i] % j));
+                        c_memset(list[i], (int)i, i);
+                }
+                for (i = 0; i < C_ARRAY_SIZE(list); ++i)
+                        for (j = 0; j < i; ++j)
+                                c_assert(list[i][j] == (uint8_t)i);
+
+                p = c_arena_alloc0(arena, 4096, 4096);
+                c_assert(p && !((uintptr_t)p % 4096));
+                for (i = 0; i < 4096; ++i)
+                        c_assert(!p[i]);
+
+                c_assert(!c_arena_alloc(arena, SIZE_MAX, 1));
+                c_assert(!c_arena_alloc(arena, SIZE_MAX - 64, 64));
+
+                mark = c_arena_mark(arena);
+                p = c_arena_alloc(arena, 8, 8);
+                for (i = 0; i < 64; ++i)
+                        c_assert(c_arena_alloc(arena, 512, 1));
+                c_arena_rewind(arena, mark);
+                q = c_arena_alloc(arena, 8, 8);
+                c_assert(p == q);
+
+                c_arena_reset(arena);
+                c_assert(arena->chunk && !arena->chunk->prev);
+                p = c_arena_alloc(arena, 8, 8);
+                c_arena_reset(arena);
+                q = c_arena_alloc(arena, 8, 8);
+                c_assert(p == q);
+
+                arena = c_arena_free(arena);
+                c_assert(!arena);
+
+                r = c_arena_new(&arena, 0);
+                c_assert(!r);
+                c_assert(arena->chunk_size == C_ARENA_CHUNK_SIZE);
+                c_arena_reset(arena);
+                c_assert(!arena->chunk);
+                c_assert(c_arena_alloc(arena, 0, 1));
+        }
+
+        /*
+         * Object pools: Verify objects are aligned and do not overlap, are
+         * reused in LIFO order after release, and oversized objects are
+         * served as well.
+         */
+        {
+                static CPool static_pool = C_POOL_INIT(3, 1);
+                _c_cleanup_(c_pool_deinitp) CPool pool = C_POOL_INIT(24, 8);
+                uint8_t *p, *q, *list[1024];
+                size_t i, j;
+
+                c_assert(static_pool.object_size == sizeof(CPoolEntry));
+                c_assert(static_pool.alignment == alignof(CPoolEntry));
+                c_assert(pool.object_size == 24);
+                c_assert(!pool.slabs);
+
+                for (i = 0; i < C_ARRAY_SIZE(list); ++i) {
+                        list[i] = c_pool_alloc(&pool);
+                        c_assert(list[i]);
+                        c_assert(!((uintptr_t)list[i] % 8));
+                        c_memset(list[i], (int)i, 24);
+                }
+                for (i = 0; i < C_ARRAY_SIZE(list); ++i)
+                        for (j = 0; j < 24; ++j)
+                                c_assert(list[i][j] == (uint8_t)i);
+
+                c_assert(!c_pool_free(&pool, NULL));
+                c_assert(!c_pool_free(&pool, list[3]));
+                c_assert(!c_pool_free(&pool, list[7]));
+                c_assert(c_pool_alloc(&pool) == list[7]);
+                c_assert(c_pool_alloc(&pool) == list[3]);
+
+                for (i = 0; i < C_ARRAY_SIZE(list); ++i)
+                        list[i] = c_pool_free(&pool, list[i]);
+                for (i = 0; i < C_ARRAY_SIZE(list); ++i)
+                        c_assert(c_pool_alloc(&pool));
+
+                c_pool_deinit(&pool);
+                c_assert(!pool.slabs && !pool.free_list && !pool.n_carve);
+
+                c_pool_init(&pool, 3 * C_POOL_SLAB_SIZE, 4096);
+                c_assert(pool.object_size == 3 * C_POOL_SLAB_SIZE);
+                p = c_pool_alloc(&pool);
+                q = c_pool_alloc(&pool);
+                c_assert(p && q && p != q);
+                c_assert(!((uintptr_t)p % 4096) && !((uintptr_t)q % 4096));
+                c_memset(p, 0, 3 * C_POOL_SLAB_SIZE);
+                c_memset(q, 0, 3 * C_POOL_SLAB_SIZE);
+                c_pool_deinit(&pool);
+
+                c_pool_init(&pool, SIZE_MAX - 1, 1);
+                c_assert(!c_pool_alloc(&pool));
+        }
+
+        /*
+         * Bit manipulation: Verify the width of the argument type is honored,
+         * 0 is well-defined, and constant arguments yield constant results.
+         * Compare against naive implementations for all 16-bit values.
+         */
+        {
+                uint64_t u64 = UINT64_C(0x8000000000000000) | (uint64_t)!!non_constant_expr;
+                unsigned int i, j, n, x;
+                uint16_t u16;
+
+                c_assert(c_clz((uint8_t)0) == 8);
+                c_assert(c_clz((uint8_t)1) == 7);
+                c_assert(c_clz((uint16_t)0x80) == 8);
+                c_assert(c_clz(UINT32_C(0)) == 32);
+                c_assert(c_clz(UINT64_C(0)) == 64);
+                c_assert(c_clz(UINT64_C(1)) == 63);
+                c_assert(c_clz(u64) == 0);
+
+                c_assert(c_ctz((uint8_t)0) == 8);
+                c_assert(c_ctz(UINT32_C(0)) == 32);
+                c_assert(c_ctz(UINT64_C(0)) == 64);
+                c_assert(c_ctz(UINT64_C(1) << 40) == 40);
+                c_assert(c_ctz(u64 - 1) == 63);
+
+                c_assert(c_popcount((uint8_t)0xff) == 8);
+                c_assert(c_popcount(UINT64_MAX) == 64);
+                c_assert(c_popcount(u64) == 2);
+
+                c_assert(c_log2(0u) == 0);
+                c_assert(c_log2((uint8_t)0xff) == 7);
+                c_assert(c_log2(UINT64_MAX) == 63);
+                c_assert(c_log2(u64) == 63);
+
+                c_assert(!c_is_pow2(0u));
+                c_assert(c_is_pow2(UINT64_C(1) << 63));
+                c_assert(!c_is_pow2(u64));
+
+                c_assert(c_next_pow2(0u) == 1);
+                c_assert(c_next_pow2((uint8_t)128) == 128);
+                c_assert(c_next_pow2((uint8_t)129) == 0);
+                c_assert(c_next_pow2(UINT32_C(0x80000001)) == 0);
+                c_assert(c_next_pow2(UINT64_C(0x8000000000000000)) == UINT64_C(0x8000000000000000));
+                c_assert(c_next_pow2(u64) == 0);
+                c_assert(c_next_pow2((u64 >> 1) + 1) == UINT64_C(0x8000000000000000));
+
+                c_assert(c_rotl((uint8_t)0x81, 1) == 0x03);
+                c_assert(c_rotr((uint8_t)0x81, 1) == 0xc0);
+                c_assert(c_rotl((uint8_t)0x81, 9) == 0x03);
+                c_assert(c_rotl(u64, 64) == u64);
+                c_assert(c_rotl(u64, 1) == 3);
+                c_assert(c_rotr(u64, 1) == UINT64_C(0xc000000000000000));
+                c_assert(c_rotr(UINT32_C(1), 33) == UINT32_C(0x80000000));
+
+                c_assert(__builtin_constant_p(c_clz(16u)));
+                c_assert(__builtin_constant_p(c_ctz(16u)));
+                c_assert(__builtin_constant_p(c_popcount(16u)));
+                c_assert(__builtin_constant_p(c_log2(16u)));
+                c_assert(__builtin_constant_p(c_is_pow2(16u)));
+                c_assert(__builtin_constant_p(c_next_pow2(17u)));
+                c_assert(__builtin_constant_p(c_rotl(16u, 3)));
+                c_assert(!__builtin_constant_p(c_clz((unsigned int)non_constant_expr)));
+                c_assert(!__builtin_constant_p(c_rotl(16u, non_constant_expr)));
+
+                x = 7;
+                c_assert(c_clz(x++) == sizeof(x) * CHAR_BIT - 3);
+                c_assert(c_next_pow2(x++) == 8);
+                c_assert(c_rotl(x++, x++) == 9u << 10);
+                c_assert(x == 11);
+
+                for (i = 0; i <= UINT16_MAX; ++i) {
+                        u16 = (uint16_t)i;
+
+                        for (n = 0; n < 16 && !(u16 & (0x8000 >> n)); ++n)
+                                ;
+                        c_assert(c_clz(u16) == (int)n);
+                        c_assert(c_log2(u16) == (u16 ? 15 - (int)n : 0));
+
+                        for (n = 0; n < 16 && !(u16 & (1 << n)); ++n)
+                                ;
+                        c_assert(c_ctz(u16) == (int)n);
+
+                        for (n = 0, j = 0; j < 16; ++j)
+                                n += !!(u16 & (1 << j));
+                        c_assert(c_popcount(u16) == (int)n);
+                        c_assert(c_is_pow2(u16) == (n == 1));
+
+                        for (n = 1; n < u16 && n <= UINT16_MAX; n <<= 1)
+                                ;
+                        c_assert(c_next_pow2(u16) == (n > UINT16_MAX ? 0 : n));
+
+                        j = i % 19;
+                        c_assert(c_rotl(u16, j) == (uint16_t)((u16 << (j % 16)) | (u16 >> ((16 - j % 16) % 16))));
+                        c_assert(c_rotr(c_rotl(u16, j), j) == u16);
+                }
+        }
 }
 
 #else /* C_MODULE_GNUC */
@@ -559,6 +1402,274 @@ static void test_basic_gnuc(int unused0) {
 
 #endif /* C_MODULE_GNUC */
 
+#if defined(C_MODULE_HASH)
+
+static void test_basic_hash(void) {
+        static const uint8_t key[16] = {
+                0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        };
+        uint8_t data[256];
+        size_t i;
+
+        for (i = 0; i < sizeof(data); ++i)
+                data[i] = (uint8_t)i;
+
+        /*
+         * Verify the SipHash implementation against the reference vectors of
+         * SipHash-2-4, and then SipHash-1-3 against the vectors of its
+         * reference implementation.
+         */
+        {
+                c_assert(c_internal_siphash(NULL, 0, key, 2, 4) == UINT64_C(0x726fdb47dd0e0e31));
+                c_assert(c_internal_siphash(data, 8, key, 2, 4) == UINT64_C(0x93f5f5799a932462));
+                c_assert(c_internal_siphash(data, 15, key, 2, 4) == UINT64_C(0xa129ca6149be45e5));
+
+                c_assert(c_siphash13(NULL, 0, key) == UINT64_C(0xabac0158050fc4dc));
+                c_assert(c_siphash13(data, 1, key) == UINT64_C(0xc9f49bf37d57ca93));
+                c_assert(c_siphash13(data, 7, key) == UINT64_C(0xd3927d989bb11140));
+                c_assert(c_siphash13(data, 8, key) == UINT64_C(0x369095118d299a8e));
+                c_assert(c_siphash13(data, 15, key) == UINT64_C(0xd320d86d2a519956));
+                c_assert(c_siphash13(data, 16, key) == UINT64_C(0xcc4fdd1a7d908b66));
+                c_assert(c_siphash13(data, 63, key) == UINT64_C(0x9d199062b7bbb3a8));
+        }
+
+        /*
+         * Verify CRC-32C against the standard check value and the iSCSI test
+         * vectors. Compare the (possibly hardware accelerated) default
+         * implementation against the table-driven one, including incremental
+         * updates and misaligned input.
+         */
+        {
+                uint8_t zero[32] = { 0 }, ones[32];
+                uint32_t crc;
+                size_t j;
+
+                c_memset(ones, 0xff, sizeof(ones));
+
+                c_assert(c_crc32c(0, "123456789", 9) == UINT32_C(0xe3069283));
+                c_assert(c_crc32c(0, zero, sizeof(zero)) == UINT32_C(0x8a9136aa));
+                c_assert(c_crc32c(0, ones, sizeof(ones)) == UINT32_C(0x62a8ab43));
+                c_assert(c_crc32c(0, data, 32) == UINT32_C(0x46dd794e));
+
+                for (i = 0; i < 64; ++i) {
+                        for (j = 0; j < 64; ++j) {
+                                crc = c_crc32c(0, data + i, j);
+                                c_assert(crc == ~c_internal_crc32c_sw(~UINT32_C(0), data + i, j));
+                                c_assert(crc == c_crc32c(c_crc32c(0, data + i, j / 3), data + i + j / 3, j - j / 3));
+                        }
+                }
+        }
+
+        /*
+         * Verify c_hash64() is deterministic, depends on the seed, the length,
+         * and every single input bit, and handles misaligned input.
+         */
+        {
+                uint8_t copy[sizeof(data) + 1];
+                uint64_t h, hashes[sizeof(data) + 1];
+                size_t j, k;
+
+                c_assert(c_hash64(NULL, 0, 0) != c_hash64(NULL, 0, 1));
+
+                for (i = 0; i <= sizeof(data); ++i) {
+                        h = c_hash64(data, i, 0);
+                        hashes[i] = h;
+
+                        c_memcpy(copy + 1, data, i);
+                        c_assert(c_hash64(copy + 1, i, 0) == h);
+                        c_assert(c_hash64(data, i, 1) != h);
+
+                        for (j = 0; j < i; ++j) {
+                                copy[1 + j] ^= 0x01;
+                                c_assert(c_hash64(copy + 1, i, 0) != h);
+                                copy[1 + j] ^= 0x81;
+                                c_assert(c_hash64(copy + 1, i, 0) != h);
+                                copy[1 + j] ^= 0x80;
+                        }
+                }
+
+                for (i = 0; i <= sizeof(data); ++i)
+                        for (k = 0; k < i; ++k)
+                                c_assert(hashes[i] != hashes[k]);
+        }
+
+        /*
+         * Verify c_hash64() reads the tail of 17 to 48 bytes long input
+         * strictly from within the buffer. The buffers are allocated to the
+         * exact size, so any stray access is caught by sanitizers (the
+         * test-suite builds this with `-fsanitize=pointer-overflow`).
+         */
+        {
+                uint8_t *buffer;
+
+                for (i = 17; i <= 48; ++i) {
+                        buffer = malloc(i);
+                        c_assert(buffer);
+                        c_memcpy(buffer, data, i);
+                        c_assert(c_hash64(buffer, i, 0) == c_hash64(data, i, 0));
+                        free(buffer);
+                }
+        }
+}
+
+#else /* C_MODULE_HASH */
+
+static void test_basic_hash(void) {
+}
+
+#endif /* C_MODULE_HASH */
+
+#if defined(C_MODULE_ATOMIC)
+
+static void test_basic_atomic(void) {
+        /*
+         * Test the atomic operations for their return values and side
+         * effects. Concurrency is not covered here, we rely on the compiler
+         * builtins for that.
+         */
+        {
+                uint64_t v = 0, e;
+                void *p = NULL;
+
+                c_atomic_store(&v, 8, C_ATOMIC_RELEASE);
+                c_assert(c_atomic_load(&v, C_ATOMIC_ACQUIRE) == 8);
+                c_assert(c_atomic_xchg(&v, 16, C_ATOMIC_ACQ_REL) == 8);
+                c_assert(c_atomic_load(&v, C_ATOMIC_RELAXED) == 16);
+
+                e = 0;
+                c_assert(!c_atomic_cmpxchg(&v, &e, 32, C_ATOMIC_ACQ_REL, C_ATOMIC_ACQUIRE));
+                c_assert(e == 16);
+                c_assert(c_atomic_cmpxchg(&v, &e, 32, C_ATOMIC_ACQ_REL, C_ATOMIC_ACQUIRE));
+                c_assert(e == 16);
+                c_assert(v == 32);
+
+                while (!c_atomic_cmpxchg_weak(&v, &e, 1, C_ATOMIC_RELEASE, C_ATOMIC_RELAXED))
+                        c_assert(e == 32);
+                c_assert(v == 1);
+
+                c_assert(c_atomic_fetch_add(&v, 2, C_ATOMIC_RELAXED) == 1);
+                c_assert(c_atomic_fetch_sub(&v, 1, C_ATOMIC_RELAXED) == 3);
+                c_assert(c_atomic_fetch_or(&v, 4, C_ATOMIC_RELAXED) == 2);
+                c_assert(c_atomic_fetch_and(&v, 3, C_ATOMIC_RELAXED) == 6);
+                c_assert(c_atomic_fetch_xor(&v, 3, C_ATOMIC_SEQ_CST) == 2);
+                c_assert(v == 1);
+
+                c_atomic_store(&p, &v, C_ATOMIC_RELEASE);
+                c_assert(c_atomic_load(&p, C_ATOMIC_ACQUIRE) == &v);
+
+                c_atomic_fence(C_ATOMIC_ACQUIRE);
+                c_atomic_fence(C_ATOMIC_RELEASE);
+                c_atomic_fence(C_ATOMIC_SEQ_CST);
+        }
+
+        /*
+         * Verify the SPSC ring in a single thread: FIFO order, capacity
+         * rounding, partial batches when full or empty, and index
+         * wrap-around.
+         */
+        {
+                _c_cleanup_(c_spsc_ring_freep) CSpscRing *ring = NULL;
+                void *in[16], *out[16], *p;
+                size_t i, j, n;
+                int r;
+
+                for (i = 0; i < C_ARRAY_SIZE(in); ++i)
+                        in[i] = (void *)(uintptr_t)(i + 1);
+
+                /* the slots must not share a cache line with anything else */
+                c_assert(!(offsetof(CSpscRing, slots) % C_CACHELINE_SIZE));
+                c_assert(offsetof(CSpscRing, slots) > offsetof(CSpscRing, mask));
+
+                r = c_spsc_ring_new(&ring, 0);
+                c_assert(!r);
+                c_assert(ring->mask == 0);
+                ring = c_spsc_ring_free(ring);
+                r = c_spsc_ring_new(&ring, SIZE_MAX / 2);
+                c_assert(r == -ENOMEM);
+
+                r = c_spsc_ring_new(&ring, 5);
+                c_assert(!r);
+                c_assert(ring->mask == 7);
+                c_assert(!((uintptr_t)ring % C_CACHELINE_SIZE));
+
+                c_assert(!c_spsc_ring_pop(ring, &p));
+                c_assert(c_spsc_ring_push_n(ring, in, 16) == 8);
+                c_assert(!c_spsc_ring_push(ring, in[0]));
+                c_assert(c_spsc_ring_pop(ring, &p) && p == in[0]);
+                c_assert(c_spsc_ring_push(ring, in[8]));
+                c_assert(c_spsc_ring_pop_n(ring, out, 16) == 8);
+                for (i = 0; i < 8; ++i)
+                        c_assert(out[i] == in[i + 1]);
+                c_assert(!c_spsc_ring_pop_n(ring, out, 16));
+
+                /* move indices through many wrap-arounds with odd batches */
+                for (i = 0, n = 0; i < 1000; ++i) {
+                        j = c_spsc_ring_push_n(ring, in, i % 5);
+                        c_assert(j == i % 5);
+                        c_assert(c_spsc_ring_pop_n(ring, out, 16) == j);
+                        while (j--)
+                                c_assert(out[j] == in[j]);
+                        n += i % 5;
+                }
+                c_assert(ring->head == n + 9 && ring->tail == n + 9);
+
+                ring = c_spsc_ring_free(ring);
+                c_assert(!ring);
+        }
+
+        /*
+         * Verify the MPMC queue in a single thread: FIFO order, capacity
+         * rounding, and sequence numbers across many laps. Concurrent use is
+         * covered by the stress tests.
+         */
+        {
+                _c_cleanup_(c_mpmc_queue_freep) CMpmcQueue *queue = NULL;
+                void *p;
+                size_t i, j;
+                int r;
+
+                r = c_mpmc_queue_new(&queue, 0);
+                c_assert(!r);
+                c_assert(queue->mask == 1);
+                queue = c_mpmc_queue_free(queue);
+                r = c_mpmc_queue_new(&queue, SIZE_MAX / 2);
+                c_assert(r == -ENOMEM);
+
+                r = c_mpmc_queue_new(&queue, 3);
+                c_assert(!r);
+                c_assert(queue->mask == 3);
+                c_assert(!((uintptr_t)queue % C_CACHELINE_SIZE));
+                c_assert(!((uintptr_t)&queue->cells[1] % C_CACHELINE_SIZE));
+
+                c_assert(!c_mpmc_queue_pop(queue, &p));
+                for (i = 0; i < 4; ++i)
+                        c_assert(c_mpmc_queue_push(queue, (void *)(uintptr_t)(i + 1)));
+                c_assert(!c_mpmc_queue_push(queue, NULL));
+                for (i = 0; i < 4; ++i)
+                        c_assert(c_mpmc_queue_pop(queue, &p) && p == (void *)(uintptr_t)(i + 1));
+                c_assert(!c_mpmc_queue_pop(queue, &p));
+
+                for (i = 0; i < 1000; ++i) {
+                        for (j = 0; j < i % 5; ++j)
+                                c_assert(c_mpmc_queue_push(queue, (void *)(uintptr_t)(i + j)));
+                        for (j = 0; j < i % 5; ++j)
+                                c_assert(c_mpmc_queue_pop(queue, &p) && p == (void *)(uintptr_t)(i + j));
+                        c_assert(!c_mpmc_queue_pop(queue, &p));
+                }
+
+                queue = c_mpmc_queue_free(queue);
+                c_assert(!queue);
+        }
+}
+
+#else /* C_MODULE_ATOMIC */
+
+static void test_basic_atomic(void) {
+}
+
+#endif /* C_MODULE_ATOMIC */
+
 #if defined(C_MODULE_UNIX)
 
 static void test_basic_unix(void) {
@@ -606,6 +1717,344 @@ static void test_basic_unix(void) {
                         c_assert(t2 == fd2);
                 }
         }
+
+        /*
+         * Test the full-length I/O helpers through a pipe. The vectored
+         * variants get more buffers than fit into a single system call,
+         * including empty ones, and must report the number of transferred
+         * bytes on end-of-file and on failure.
+         */
+        {
+                _c_cleanup_(c_closep) int rfd = -1, wfd = -1;
+                struct iovec iov[2048];
+                char in[2048], out[4096];
+                size_t i, n;
+                int r, tmp[2];
+
+                r = pipe(tmp);
+                c_assert(r >= 0);
+                rfd = tmp[0];
+                wfd = tmp[1];
+
+                for (i = 0; i < sizeof(in); ++i)
+                        in[i] = (char)i;
+
+                r = c_write_full(wfd, in, sizeof(in), &n);
+                c_assert(!r && n == sizeof(in));
+                r = c_read_full(rfd, out, sizeof(in), NULL);
+                c_assert(!r);
+                c_assert(!memcmp(in, out, sizeof(in)));
+
+                for (i = 0; i < C_ARRAY_SIZE(iov); ++i) {
+                        iov[i].iov_base = in + i;
+                        iov[i].iov_len = i % 3 ? 1 : 0;
+                }
+                r = c_writev_full(wfd, iov, C_ARRAY_SIZE(iov), &n);
+                c_assert(!r && n == 1365);
+
+                for (i = 0; i < C_ARRAY_SIZE(iov); ++i) {
+                        iov[i].iov_base = out + 2 * i;
+                        iov[i].iov_len = i % 2 ? 0 : 2;
+                }
+                wfd = c_close(wfd);
+                r = c_readv_full(rfd, iov, C_ARRAY_SIZE(iov), &n);
+                c_assert(!r && n == 1365);
+                for (i = 0, n = 0; i < C_ARRAY_SIZE(iov); ++i) {
+                        if (i % 3) {
+                                c_assert(out[4 * (n / 2) + n % 2] == in[i]);
+                                ++n;
+                        }
+                }
+
+                /* end-of-file is not an error, but stops early */
+                r = c_read_full(rfd, out, sizeof(out), &n);
+                c_assert(!r && n == 0);
+
+                r = c_write_full(-1, in, sizeof(in), &n);
+                c_assert(r == -EBADF && n == 0);
+                r = c_writev_full(-1, iov, C_ARRAY_SIZE(iov), NULL);
+                c_assert(r == -EBADF);
+                r = c_read_full(-1, out, 0, &n);
+                c_assert(!r && n == 0);
+        }
+
+        /*
+         * Test file mappings. Map a temporary file read-only with all
+         * advice flags, then writable and verify writes reach the file.
+         * Empty files, non-regular files, and missing files are covered as
+         * well.
+         */
+        {
+                _c_cleanup_(c_file_map_freep) CFileMap *map = NULL;
+                char path[] = "/tmp/c-stdaux-test-XXXXXX", buf[8192];
+                size_t i;
+                int r, fd;
+
+                for (i = 0; i < sizeof(buf); ++i)
+                        buf[i] = (char)(i * 7);
+
+                fd = mkstemp(path);
+                c_assert(fd >= 0);
+
+                r = c_file_map_new(&map, path, 0);
+                c_assert(!r);
+                c_assert(!map->data && !map->size);
+                map = c_file_map_free(map);
+                c_assert(!map);
+
+                r = c_write_full(fd, buf, sizeof(buf), NULL);
+                c_assert(!r);
+
+                r = c_file_map_new(&map, path, C_FILE_MAP_SEQUENTIAL | C_FILE_MAP_RANDOM |
+                                               C_FILE_MAP_WILLNEED | C_FILE_MAP_POPULATE);
+                c_assert(!r);
+                c_assert(map->size == sizeof(buf));
+                c_assert(!memcmp(map->data, buf, sizeof(buf)));
+                map = c_file_map_free(map);
+
+                r = c_file_map_new(&map, path, C_FILE_MAP_WRITABLE);
+                c_assert(!r);
+                ((char *)map->data)[sizeof(buf) - 1] = 'x';
+                map = c_file_map_free(map);
+
+                r = pread(fd, buf, 1, sizeof(buf) - 1);
+                c_assert(r == 1 && buf[0] == 'x');
+
+                r = c_file_map_new(&map, "/tmp", 0);
+                c_assert(r == -EINVAL);
+                r = unlink(path);
+                c_assert(!r);
+                r = c_file_map_new(&map, path, 0);
+                c_assert(r == -ENOENT);
+                c_assert(!map);
+
+                fd = c_close(fd);
+        }
+
+        /*
+         * Test c_copy_fd() with combinations of files and pipes, so all the
+         * different copy methods are used on Linux. An append-only output
+         * file rejects most of them, so the fallbacks are exercised as well.
+         */
+        {
+                char path[] = "/tmp/c-stdaux-test-XXXXXX", in[16384], out[16384];
+                int r, src, dst, tmp[2];
+                size_t i, n;
+
+                for (i = 0; i < sizeof(in); ++i)
+                        in[i] = (char)(i * 13);
+
+                src = mkstemp(path);
+                c_assert(src >= 0);
+                r = unlink(path);
+                c_assert(!r);
+                r = c_write_full(src, in, sizeof(in), NULL);
+                c_assert(!r);
+
+                /* file to file, limited to a part of the file */
+                strcpy(path, "/tmp/c-stdaux-test-XXXXXX");
+                dst = mkstemp(path);
+                c_assert(dst >= 0);
+                c_assert(lseek(src, 0, SEEK_SET) == 0);
+                r = c_copy_fd(src, dst, 1000, &n);
+                c_assert(!r && n == 1000);
+                r = c_copy_fd(src, dst, SIZE_MAX, &n);
+                c_assert(!r && n == sizeof(in) - 1000);
+                r = c_copy_fd(src, dst, SIZE_MAX, &n);
+                c_assert(!r && n == 0);
+                c_assert(pread(dst, out, sizeof(out), 0) == (ssize_t)sizeof(out));
+                c_assert(!memcmp(in, out, sizeof(in)));
+                dst = c_close(dst);
+
+                /* file to append-only file */
+                dst = open(path, O_WRONLY | O_APPEND | O_CLOEXEC);
+                c_assert(dst >= 0);
+                c_assert(lseek(src, 0, SEEK_SET) == 0);
+                r = c_copy_fd(src, dst, SIZE_MAX, &n);
+                c_assert(!r && n == sizeof(in));
+                dst = c_close(dst);
+                dst = open(path, O_RDONLY | O_CLOEXEC);
+                c_assert(dst >= 0);
+                c_assert(pread(dst, out, sizeof(out), sizeof(in)) == (ssize_t)sizeof(out));
+                c_assert(!memcmp(in, out, sizeof(in)));
+                dst = c_close(dst);
+                r = unlink(path);
+                c_assert(!r);
+
+                /* file to pipe */
+                r = pipe(tmp);
+                c_assert(r >= 0);
+                c_assert(lseek(src, 0, SEEK_SET) == 0);
+                r = c_copy_fd(src, tmp[1], 8192, &n);
+                c_assert(!r && n == 8192);
+                src = c_close(src);
+                src = tmp[0];
+                tmp[0] = c_close(tmp[1]);
+
+                /* pipe to pipe, with the input reaching end-of-file */
+                r = pipe(tmp);
+                c_assert(r >= 0);
+                r = c_copy_fd(src, tmp[1], 1000, &n);
+                c_assert(!r && n == 1000);
+                r = c_copy_fd(src, tmp[1], SIZE_MAX, &n);
+                c_assert(!r && n == 8192 - 1000);
+                r = c_copy_fd(src, tmp[1], SIZE_MAX, &n);
+                c_assert(!r && n == 0);
+                r = c_read_full(tmp[0], out, 8192, &n);
+                c_assert(!r && n == 8192);
+                c_assert(!memcmp(in, out, 8192));
+
+                c_close(tmp[0]);
+                c_close(tmp[1]);
+                c_close(src);
+
+                r = c_copy_fd(-1, -1, SIZE_MAX, &n);
+                c_assert(r == -EBADF && n == 0);
+        }
+
+        /*
+         * Test c_close_range() and c_closefrom(), as well as their fallbacks,
+         * on a set of file descriptors just below the file-descriptor limit, so
+         * they are above all others. Only the requested range must be closed.
+         */
+        {
+                struct rlimit rl;
+                int r, i, j, fd, base;
+
+                fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                c_assert(fd >= 0);
+
+                r = getrlimit(RLIMIT_NOFILE, &rl);
+                c_assert(!r);
+                base = (rl.rlim_cur < 1024 ? (int)rl.rlim_cur : 1024) - 16;
+                c_assert(base > fd);
+
+                for (i = 0; i < 3; ++i) {
+                        for (j = 0; j < 8; ++j) {
+                                r = dup2(fd, base + j);
+                                c_assert(r == base + j);
+                        }
+
+                        if (i == 0) {
+                                r = c_close_range(base + 2, base + 5);
+                        } else if (i == 1) {
+                                r = c_internal_close_range_dir(base + 2, base + 5);
+                        } else {
+                                c_internal_close_range_all(base + 2, base + 5);
+                                r = 0;
+                        }
+                        c_assert(!r);
+
+                        for (j = 0; j < 8; ++j) {
+                                r = fcntl(base + j, F_GETFD);
+                                c_assert((j >= 2 && j <= 5) == (r < 0));
+                        }
+                }
+
+                r = c_closefrom(base);
+                c_assert(!r);
+                for (j = 0; j < 8; ++j)
+                        c_assert(fcntl(base + j, F_GETFD) < 0);
+                c_assert(fcntl(fd, F_GETFD) >= 0);
+
+                c_assert(c_close_range(-1, 5) == -EINVAL);
+                c_assert(c_close_range(5, 4) == -EINVAL);
+                c_assert(c_closefrom(-1) == -EINVAL);
+
+                fd = c_close(fd);
+        }
+
+        /*
+         * Test directory iterators. Enumerate a temporary directory with
+         * enough entries to need several batches, and verify every entry is
+         * returned exactly once, with a file type matching its attributes.
+         */
+        {
+                _c_cleanup_(c_dir_iter_freep) CDirIter *iter = NULL;
+                char path[] = "/tmp/c-stdaux-test-XXXXXX", name[32];
+                const CDirEntry *entry;
+                bool seen[4096 + 2] = {};
+                struct stat st;
+                size_t i;
+                int r, fd;
+
+                c_assert(mkdtemp(path));
+
+                r = c_dir_iter_new(&iter, AT_FDCWD, path);
+                c_assert(!r);
+                r = c_dir_iter_next(iter, &entry);
+                c_assert(!r && !entry);
+                iter = c_dir_iter_free(iter);
+                c_assert(!iter);
+
+                r = c_dir_iter_new(&iter, AT_FDCWD, path);
+                c_assert(!r);
+
+                for (i = 0; i < 4096; ++i) {
+                        snprintf(name, sizeof(name), "f%zu", i);
+                        fd = openat(iter->fd, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+                        c_assert(fd >= 0);
+                        fd = c_close(fd);
+                }
+                r = mkdirat(iter->fd, "d", 0700);
+                c_assert(!r);
+                r = symlinkat("f0", iter->fd, "l");
+                c_assert(!r);
+
+                while ((r = c_dir_iter_next(iter, &entry)) > 0) {
+                        r = c_dir_iter_stat(iter, entry, &st);
+                        c_assert(!r);
+                        c_assert(entry->ino == (uint64_t)st.st_ino);
+
+                        if (!strcmp(entry->name, "d")) {
+                                c_assert(S_ISDIR(st.st_mode));
+                                c_assert(entry->type == DT_DIR || entry->type == DT_UNKNOWN);
+                                i = 4096;
+                        } else if (!strcmp(entry->name, "l")) {
+                                c_assert(S_ISLNK(st.st_mode));
+                                c_assert(entry->type == DT_LNK || entry->type == DT_UNKNOWN);
+                                i = 4097;
+                        } else {
+                                c_assert(S_ISREG(st.st_mode));
+                                c_assert(entry->type == DT_REG || entry->type == DT_UNKNOWN);
+                                c_assert(entry->name[0] == 'f');
+                                i = strtoul(entry->name + 1, NULL, 10);
+                                c_assert(i < 4096);
+                        }
+
+                        c_assert(!seen[i]);
+                        seen[i] = true;
+                }
+                c_assert(!r && !entry);
+
+                for (i = 0; i < C_ARRAY_SIZE(seen); ++i)
+                        c_assert(seen[i]);
+
+                r = c_dir_iter_next(iter, &entry);
+                c_assert(!r && !entry);
+
+                for (i = 0; i < 4096; ++i) {
+                        snprintf(name, sizeof(name), "f%zu", i);
+                        r = unlinkat(iter->fd, name, 0);
+                        c_assert(!r);
+                }
+                r = unlinkat(iter->fd, "d", AT_REMOVEDIR);
+                c_assert(!r);
+                r = unlinkat(iter->fd, "l", 0);
+                c_assert(!r);
+
+                r = c_dir_iter_stat(iter, &(CDirEntry){ .name = "l" }, &st);
+                c_assert(r == -ENOENT);
+
+                iter = c_dir_iter_free(iter);
+                r = rmdir(path);
+                c_assert(!r);
+
+                r = c_dir_iter_new(&iter, AT_FDCWD, path);
+                c_assert(r == -ENOENT);
+                r = c_dir_iter_new(&iter, AT_FDCWD, "/dev/null");
+                c_assert(r == -ENOTDIR);
+        }
 }
 
 #else /* C_MODULE_UNIX */
@@ -619,6 +2068,8 @@ int main(int argc, char **argv) {
         (void)argv;
         test_basic_generic(argc);
         test_basic_gnuc(argc);
+        test_basic_hash();
+        test_basic_atomic();
         test_basic_unix();
         return 0;
 }
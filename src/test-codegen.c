@@ -0,0 +1,180 @@
+/*
+ * Code Generation Probes
+ *
+ * This is compiled with optimizations enabled and then disassembled by
+ * `test-codegen.sh`, which verifies that each probe function stays within its
+ * instruction budget (see the script for the budgets). This guards the
+ * zero-overhead promise of the helpers against compiler regressions. Probes
+ * must be exported, so they are neither inlined nor discarded.
+ */
+
+#undef NDEBUG
+#include <stdlib.h>
+#include "c-stdaux.h"
+
+#define PROBE(_ret, _name, _args)                                       \
+        _c_public_ _ret _name _args;                                    \
+        _c_public_ _ret _name _args
+
+PROBE(uint32_t, probe_load_32le_aligned, (const void *p)) {
+        return c_load_32le_aligned(p, 0);
+}
+
+PROBE(uint64_t, probe_load_64le_unaligned, (const void *p)) {
+        return c_load_64le_unaligned(p, 1);
+}
+
+PROBE(uint16_t, probe_load_16be_unaligned, (const void *p)) {
+        return c_load_16be_unaligned(p, 1);
+}
+
+PROBE(uint32_t, probe_load_32be_unaligned, (const void *p)) {
+        return c_load_32be_unaligned(p, 1);
+}
+
+PROBE(uint64_t, probe_load_64be_unaligned, (const void *p)) {
+        return c_load_64be_unaligned(p, 1);
+}
+
+PROBE(uint64_t, probe_load_48le_unaligned, (const void *p)) {
+        return c_load_48le_unaligned(p, 1);
+}
+
+#if defined(__SIZEOF_INT128__)
+PROBE(unsigned __int128, probe_load_128be_unaligned, (const void *p)) {
+        return c_load_128be_unaligned(p, 1);
+}
+#endif
+
+PROBE(void, probe_store_32le_aligned, (void *p, uint32_t v)) {
+        c_store_32le_aligned(p, 0, v);
+}
+
+PROBE(void, probe_store_64be_unaligned, (void *p, uint64_t v)) {
+        c_store_64be_unaligned(p, 1, v);
+}
+
+PROBE(void, probe_memcpy_16, (void *dst, const void *src)) {
+        c_memcpy(dst, src, 16);
+}
+
+PROBE(void, probe_memzero_32, (void *p)) {
+        c_memzero(p, 32);
+}
+
+PROBE(uint64_t, probe_max, (uint64_t a, uint64_t b)) {
+        return c_max(a, b);
+}
+
+PROBE(uint64_t, probe_align_to_8, (uint64_t v)) {
+        return c_align_to(v, 8);
+}
+
+PROBE(uint64_t, probe_div_round_up_8, (uint64_t v)) {
+        return c_div_round_up(v, UINT64_C(8));
+}
+
+PROBE(int, probe_clz_64, (uint64_t v)) {
+        return c_clz(v);
+}
+
+PROBE(int, probe_ctz_32, (uint32_t v)) {
+        return c_ctz(v);
+}
+
+PROBE(uint64_t, probe_next_pow2_64, (uint64_t v)) {
+        return c_next_pow2(v);
+}
+
+PROBE(uint64_t, probe_rotl_64, (uint64_t v, unsigned int n)) {
+        return c_rotl(v, n);
+}
+
+PROBE(bool, probe_mul_overflow_size, (size_t a, size_t b, size_t *res)) {
+        return c_mul_overflow(a, b, res);
+}
+
+PROBE(uint64_t, probe_add_sat_64, (uint64_t a, uint64_t b)) {
+        return c_add_sat(a, b);
+}
+
+PROBE(uint64_t, probe_mul_sat_64, (uint64_t a, uint64_t b)) {
+        return c_mul_sat(a, b);
+}
+
+PROBE(uint32_t, probe_assume_mod, (uint32_t v)) {
+        c_assume(v < 100);
+        return v % 100;
+}
+
+PROBE(int, probe_unreachable_switch, (unsigned int v)) {
+        switch (v) {
+        case 0: return 17;
+        case 1: return 23;
+        case 2: return 42;
+        case 3: return 71;
+        default: c_unreachable();
+        }
+}
+
+/*
+ * The allocators used by the probes below are weak, so the compiler cannot
+ * look into their definitions and has to rely on the attributes.
+ */
+
+_c_public_ __attribute__((__weak__)) _c_returns_nonnull_ void *probe_internal_nonnull(void);
+_c_public_ __attribute__((__weak__)) void *probe_internal_nonnull(void) {
+        static int v;
+        return &v;
+}
+
+_c_public_ __attribute__((__weak__)) _c_malloc_ _c_alloc_size_(1) void *probe_internal_alloc(size_t n);
+_c_public_ __attribute__((__weak__)) void *probe_internal_alloc(size_t n) {
+        return malloc(n);
+}
+
+_c_public_ __attribute__((__weak__)) _c_nonnull_(1) int probe_internal_get(const int *p);
+_c_public_ __attribute__((__weak__)) int probe_internal_get(const int *p) {
+        return *p;
+}
+
+PROBE(int, probe_nonnull, (const int *p)) {
+        int v = probe_internal_get(p);
+
+        return p ? v : -1;
+}
+
+PROBE(int, probe_returns_nonnull, (void)) {
+        int r;
+
+        /* several checks, so a missed hint costs more than compiler noise */
+        r = !!probe_internal_nonnull();
+        r += !!probe_internal_nonnull();
+        r += !!probe_internal_nonnull();
+        return r;
+}
+
+PROBE(int, probe_malloc, (int *p)) {
+        int *a, *b, *c;
+
+        /* without the hint, every store might clobber the others */
+        a = probe_internal_alloc(sizeof(*a));
+        b = probe_internal_alloc(sizeof(*b));
+        c = probe_internal_alloc(sizeof(*c));
+        *a = 1;
+        *b = 2;
+        *c = 4;
+        *p = 0;
+        return *a + *b + *c;
+}
+
+PROBE(void *, probe_alloc_size, (void)) {
+        void *p = probe_internal_alloc(16);
+
+        return __builtin_object_size(p, 0) == 16 ? p : NULL;
+}
+
+int main(void) {
+        /* This is never run for real, it only provides the probes. */
+        return 0;
+}
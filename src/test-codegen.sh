@@ -0,0 +1,112 @@
+#!/bin/sh
+#
+# Code Generation Tests
+#
+# This disassembles the probe functions of `test-codegen` and verifies that
+# each of them stays within its instruction budget and does not call any
+# other function. Probes that verify the effect of attributes on callers may
+# allow a number of calls in a third column. Probes that are only built on
+# some targets (e.g., if `__int128` is supported) are marked `optional` in a
+# fourth column, and are skipped if missing. Alignment padding and CET markers
+# are not counted, but the final `ret` is. Code the compiler moves out of line
+# into a `.cold` part is counted towards its probe.
+#
+# The budgets are tailored to x86-64. Each is the count produced by GCC 12 at
+# -O2, plus half of it, but at least 2 more, so other compilers and versions
+# have some room. This still catches regressions, which usually cost far more
+# than that. Probes that verify optimizer hints are shaped so the count without
+# the hint exceeds the budget, or includes a call that is not allowed.
+#
+# Usage: test-codegen.sh <objdump> <test-codegen>
+#
+
+set -e
+
+objdump="$1"
+binary="$2"
+
+budgets="
+probe_load_32le_aligned         4
+probe_load_64le_unaligned       4
+probe_load_16be_unaligned       5
+probe_load_32be_unaligned       5
+probe_load_64be_unaligned       5
+probe_load_48le_unaligned       7
+probe_load_128be_unaligned      7       0       optional
+probe_store_32le_aligned        4
+probe_store_64be_unaligned      5
+probe_memcpy_16                 5
+probe_memzero_32                6
+probe_max                       6
+probe_align_to_8                5
+probe_div_round_up_8            9
+probe_clz_64                    9
+probe_ctz_32                    9
+probe_next_pow2_64              13
+probe_rotl_64                   6
+probe_mul_overflow_size         9
+probe_add_sat_64                6
+probe_mul_sat_64                9
+probe_assume_mod                4
+probe_unreachable_switch        6
+probe_nonnull                   3       1
+probe_returns_nonnull           10      3
+probe_malloc                    18      3
+probe_alloc_size                4       1
+"
+
+"$objdump" -d --no-show-raw-insn "$binary" | awk -v budgets="$budgets" '
+        BEGIN {
+                n = split(budgets, lines, "\n")
+                for (i = 1; i <= n; ++i) {
+                        if (split(lines[i], f, " ") >= 2) {
+                                budget[f[1]] = f[2]
+                                allowed[f[1]] = f[3] + 0
+                                optional[f[1]] = f[4] == "optional"
+                                count[f[1]] = -1
+                        }
+                }
+        }
+
+        /^[0-9a-f]+ <[^>]*>:$/ {
+                fn = substr($2, 2, length($2) - 3)
+                sub(/\.cold$/, "", fn)
+                if (fn in budget && count[fn] < 0)
+                        count[fn] = 0
+                next
+        }
+
+        /^$/ {
+                fn = ""
+                next
+        }
+
+        fn in budget && split($0, f, "\t") >= 2 {
+                insn = f[2]
+                if (insn ~ /^(endbr|nop|xchg +%ax,%ax|int3|data16|cs nopw)/)
+                        next
+
+                ++count[fn]
+                code[fn] = code[fn] "\n        " insn
+                if (insn ~ /^(call|jmp +[0-9a-f]+ <[^+>]*>$)/)
+                        ++calls[fn]
+        }
+
+        END {
+                r = 0
+                for (fn in budget) {
+                        if (count[fn] < 0 && optional[fn]) {
+                                print "skip " fn ": probe not built"
+                        } else if (count[fn] < 0) {
+                                print "FAIL " fn ": probe not found"
+                                r = 1
+                        } else if (count[fn] > budget[fn] || calls[fn] > allowed[fn]) {
+                                print "FAIL " fn ": " count[fn] " instructions (budget " budget[fn] ")" code[fn]
+                                r = 1
+                        } else {
+                                print "ok   " fn ": " count[fn] " instructions (budget " budget[fn] ")"
+                        }
+                }
+                exit r
+        }
+'
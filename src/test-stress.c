@@ -0,0 +1,172 @@
+/*
+ * Stress Tests
+ *
+ * This runs the concurrent data structures from several threads at once and
+ * verifies that no element is lost, duplicated, or reordered. Unlike the
+ * basic tests, these rely on actual parallelism, so a failure might only show
+ * up on some runs. Run them under a thread sanitizer to get reliable reports.
+ */
+
+#undef NDEBUG
+#include <stdlib.h>
+#include "c-stdaux.h"
+
+#if defined(C_MODULE_ATOMIC)
+
+#include <pthread.h>
+#include <sched.h>
+
+#define TEST_STRESS_N_ITEMS 100000
+#define TEST_STRESS_N_THREADS 4
+
+typedef struct {
+        CSpscRing *ring;
+        CMpmcQueue *queue;
+        size_t id;
+        size_t n_popped;
+        uint8_t *seen;
+} TestStress;
+
+static void *test_spsc_producer(void *userdata) {
+        TestStress *t = userdata;
+        void *items[7];
+        size_t i, j, k, n;
+
+        /* push in odd batch sizes, so indices wrap at varying offsets */
+        for (i = 0, j = 0; i < TEST_STRESS_N_ITEMS; i += j) {
+                j = c_min((size_t)TEST_STRESS_N_ITEMS - i, i % 7 + 1);
+                for (k = 0; k < j; ++k)
+                        items[k] = (void *)(uintptr_t)(i + k + 1);
+                for (k = 0; k < j; k += n)
+                        if (!(n = c_spsc_ring_push_n(t->ring, items + k, j - k)))
+                                sched_yield();
+        }
+
+        return NULL;
+}
+
+static void test_spsc(void) {
+        TestStress t = {};
+        pthread_t thread;
+        void *items[5];
+        size_t i, j, k;
+        int r;
+
+        r = c_spsc_ring_new(&t.ring, 16);
+        c_assert(!r);
+
+        r = pthread_create(&thread, NULL, test_spsc_producer, &t);
+        c_assert(!r);
+
+        for (i = 0; i < TEST_STRESS_N_ITEMS; i += j) {
+                j = c_spsc_ring_pop_n(t.ring, items, C_ARRAY_SIZE(items));
+                if (!j)
+                        sched_yield();
+                for (k = 0; k < j; ++k)
+                        c_assert(items[k] == (void *)(uintptr_t)(i + k + 1));
+        }
+
+        r = pthread_join(thread, NULL);
+        c_assert(!r);
+
+        c_assert(!c_spsc_ring_pop_n(t.ring, items, C_ARRAY_SIZE(items)));
+        t.ring = c_spsc_ring_free(t.ring);
+}
+
+static void *test_mpmc_producer(void *userdata) {
+        TestStress *t = userdata;
+        size_t i, v;
+
+        for (i = 0; i < TEST_STRESS_N_ITEMS; ++i) {
+                v = t->id * TEST_STRESS_N_ITEMS + i + 1;
+                while (!c_mpmc_queue_push(t->queue, (void *)(uintptr_t)v))
+                        sched_yield();
+        }
+
+        return NULL;
+}
+
+static void *test_mpmc_consumer(void *userdata) {
+        size_t last[TEST_STRESS_N_THREADS] = {};
+        TestStress *t = userdata;
+        size_t v, producer;
+        void *p;
+
+        while (c_atomic_load(&t->n_popped, C_ATOMIC_RELAXED) <
+               TEST_STRESS_N_THREADS * TEST_STRESS_N_ITEMS) {
+                if (!c_mpmc_queue_pop(t->queue, &p)) {
+                        sched_yield();
+                        continue;
+                }
+
+                c_atomic_fetch_add(&t->n_popped, 1, C_ATOMIC_RELAXED);
+
+                /* every element must be seen exactly once... */
+                v = (uintptr_t)p;
+                c_assert(v > 0 && v <= TEST_STRESS_N_THREADS * TEST_STRESS_N_ITEMS);
+                c_assert(!c_atomic_xchg(&t->seen[v - 1], 1, C_ATOMIC_RELAXED));
+
+                /* ...and in order relative to its producer */
+                producer = (v - 1) / TEST_STRESS_N_ITEMS;
+                c_assert(v > last[producer]);
+                last[producer] = v;
+        }
+
+        return NULL;
+}
+
+static void test_mpmc(void) {
+        pthread_t producers[TEST_STRESS_N_THREADS], consumers[TEST_STRESS_N_THREADS];
+        TestStress t = {}, producer_ctx[TEST_STRESS_N_THREADS];
+        size_t i;
+        void *p;
+        int r;
+
+        r = c_mpmc_queue_new(&t.queue, 64);
+        c_assert(!r);
+        t.seen = calloc(TEST_STRESS_N_THREADS * TEST_STRESS_N_ITEMS, 1);
+        c_assert(t.seen);
+
+        for (i = 0; i < TEST_STRESS_N_THREADS; ++i) {
+                producer_ctx[i] = t;
+                producer_ctx[i].id = i;
+        }
+
+        for (i = 0; i < TEST_STRESS_N_THREADS; ++i) {
+                r = pthread_create(&producers[i], NULL, test_mpmc_producer, &producer_ctx[i]);
+                c_assert(!r);
+                r = pthread_create(&consumers[i], NULL, test_mpmc_consumer, &t);
+                c_assert(!r);
+        }
+
+        for (i = 0; i < TEST_STRESS_N_THREADS; ++i) {
+                r = pthread_join(producers[i], NULL);
+                c_assert(!r);
+                r = pthread_join(consumers[i], NULL);
+                c_assert(!r);
+        }
+
+        c_assert(t.n_popped == TEST_STRESS_N_THREADS * TEST_STRESS_N_ITEMS);
+        for (i = 0; i < TEST_STRESS_N_THREADS * TEST_STRESS_N_ITEMS; ++i)
+                c_assert(t.seen[i]);
+        c_assert(!c_mpmc_queue_pop(t.queue, &p));
+
+        free(t.seen);
+        t.queue = c_mpmc_queue_free(t.queue);
+}
+
+#else /* C_MODULE_ATOMIC */
+
+static void test_spsc(void) {
+}
+
+static void test_mpmc(void) {
+}
+
+#endif /* C_MODULE_ATOMIC */
+
+int main(void) {
+        test_spsc();
+        test_mpmc();
+        return 0;
+}